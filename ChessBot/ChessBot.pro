@@ -12,9 +12,11 @@ SOURCES += \
     src/engine_core/ai_logic/evaluation.cpp \
     src/engine_core/ai_logic/move_ordering.cpp \
     src/engine_core/ai_logic/search.cpp \
+    src/engine_core/ai_logic/search_history.cpp \
     src/engine_core/ai_logic/static_exchange_evaluation.cpp \
     src/engine_core/ai_logic/transposition_table.cpp \
     src/engine_core/board_state/bitboard.cpp \
+    src/engine_core/board_state/cuckoo_table.cpp \
     src/engine_core/board_state/move.cpp \
     src/engine_core/board_state/pieces.cpp \
     src/engine_core/board_state/position.cpp \
@@ -35,9 +37,11 @@ HEADERS += \
     src/engine_core/ai_logic/piece_values.h \
     src/engine_core/ai_logic/pst_tables.h \
     src/engine_core/ai_logic/search.h \
+    src/engine_core/ai_logic/search_history.h \
     src/engine_core/ai_logic/static_exchange_evaluation.h \
     src/engine_core/ai_logic/transposition_table.h \
     src/engine_core/board_state/bitboard.h \
+    src/engine_core/board_state/cuckoo_table.h \
     src/engine_core/board_state/move.h \
     src/engine_core/board_state/pieces.h \
     src/engine_core/board_state/position.h \
@@ -251,12 +251,13 @@ static int ComputeCapturingPenalty(const Position& pos) {
             continue;
         }
 
-        // SquareInDanger returns true if side owner attacks its own square (piece is attacked by enemy)
-        if (!PsLegalMaskGen::SquareInDanger(pieces, sq, owner)) {
+        Side attacker = Pieces::Inverse(owner);
+
+        // Only pieces attacked by the enemy can be under a capturing threat
+        if (!(PsLegalMaskGen::AttackersTo(pieces, sq, occ) & pieces.GetSideBoard(attacker))) {
             continue;
         }
 
-        Side attacker = Pieces::Inverse(owner);
         int see_for_attacker = StaticExchangeEvaluation::On(pieces, sq, owner);
 
         // Condition (1): side to move equals attacker and SEE is non-negative
@@ -796,14 +797,15 @@ static int PawnShieldPenalty(const Pieces& pieces, Side side, uint8_t king_sq) {
 static int KingRingDangerPenalty(const Pieces& pcs, Side side, uint8_t ksq) {
     int penalty = 0;
 
-    Bitboard ring = KingMasks::kMasks[ksq];
-    Bitboard bb = ring;
+    const Bitboard occ = pcs.GetAllBitboard();
+    const Bitboard enemy = pcs.GetSideBoard(Pieces::Inverse(side));
+    Bitboard bb = KingMasks::kMasks[ksq];
 
     while (bb) {
         const uint8_t sq = BOp::BitScanForward(bb);
         bb = BOp::Set_0(bb, sq);
 
-        if (PsLegalMaskGen::SquareInDanger(pcs, sq, side)) {
+        if (PsLegalMaskGen::AttackersTo(pcs, sq, occ) & enemy) {
             penalty += 4;
         }
     }
@@ -135,6 +135,11 @@ int MoveOrdering::Score(const Move& move, const Pieces& pieces, const Context& c
 
             int see_value = StaticExchangeEvaluation::Capture(pieces, move);
             int score = 500000 + mvv_lva + Clamp(see_value, -500, 500);
+
+            // Capture history breaks ties between captures of similar material balance
+            if (ctx.history != nullptr) {
+                score += ctx.history->GetCapture(move) / 16;
+            }
             return score;
         }
         default: {
@@ -157,26 +162,17 @@ int MoveOrdering::Score(const Move& move, const Pieces& pieces, const Context& c
         return 290000;
     }
 
-    // 6) History heuristic for simple moves
-    int history_score = 0;
-    if (ctx.history != nullptr) {
-        int side_index = static_cast<int>(ctx.side_to_move);
-        int from = static_cast<int>(move.GetFrom());
-        int to   = static_cast<int>(move.GetTo());
-        int hval = (*ctx.history)[side_index][from][to];
-
-        if (hval < 0) {
-            hval = 0;
-        }
-
-        if (hval > 16384) {
-            hval = 16384;
-        }
-
-        history_score = 100000 + hval;
+    // 6) Countermove: the reply that refuted the opponent's previous move
+    if (SameKey(ctx.countermove, move)) {
+        return 280000;
     }
-    else {
-        history_score = 100000;
+
+    // 7) Butterfly and continuation history for simple moves
+    int history_score = 100000;
+    if (ctx.history != nullptr) {
+        history_score += ctx.history->GetButterfly(ctx.side_to_move, move);
+        history_score += SearchHistory::ContinuationValue(ctx.continuation[0], move);
+        history_score += SearchHistory::ContinuationValue(ctx.continuation[1], move);
     }
 
     return history_score;
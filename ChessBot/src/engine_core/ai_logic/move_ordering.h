@@ -1,15 +1,17 @@
 /*
  * Move ordering — context and scoring API.
  * Contents:
- *   - struct Context: tt_move, cutoff1, cutoff2, history, side_to_move.
+ *   - struct Context: tt_move, cutoff1, cutoff2, countermove, history, continuation rows, side_to_move.
  *   - Score(...): returns scalar priority for sorting moves (higher is better).
- * Scoring order: TT move → promotions/EP → captures (MVV-LVA + SEE) → CutoffMoves → History → SimpleMoves.
+ * Scoring order: TT move → promotions/EP → captures (MVV-LVA + SEE + capture history) → CutoffMoves →
+ * Countermove → butterfly + continuation history → SimpleMoves.
  */
 
 #pragma once
 
 #include "../board_state/pieces.h"
 #include "../board_state/move.h"
+#include "search_history.h"
 
 class MoveOrdering {
 public:
@@ -17,7 +19,10 @@ public:
         Move tt_move;
         uint16_t cutoff1;
         uint16_t cutoff2;
-        const int (*history)[2][64][64];
+        uint16_t countermove;
+        const SearchHistory* history;
+        // Continuation rows for the moves 1 and 2 halfmoves back (nullptr if absent)
+        const SearchHistory::PieceToHistory* continuation[2];
         Side side_to_move;
     };
 
@@ -1,5 +1,6 @@
-#include <vector>
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 
 #include "search.h"
@@ -20,6 +21,38 @@ constexpr int kInfinity = 32000;
 constexpr int kMateScore = 31000;
 constexpr int kMateThreshold = kMateScore - 1024;
 
+// Node pruning parameters (non-PV nodes)
+constexpr int kReverseFutilityDepth  = 6;
+constexpr int kReverseFutilityMargin = 90;  // per ply of remaining depth
+constexpr int kProbCutDepth          = 5;
+constexpr int kProbCutMargin         = 200;
+constexpr int kProbCutReduction      = 4;
+
+// Aspiration windows: first depth searched with a window around the previous score and its
+// initial half-width; a failed bound moves out by a delta that grows by half on every re-search
+constexpr int kAspirationDepth = 5;
+constexpr int kAspirationDelta = 25;
+
+// Ordering score of the root list ranks (above the TT move)
+constexpr int kRootOrderScore = 2000000;
+
+// Late move reductions indexed by [depth][move_index], built once at startup:
+// r = 0.5 + ln(depth) * ln(move_index) / 2.5
+constexpr int kLmrSize = 64;
+
+std::array<std::array<int8_t, kLmrSize>, kLmrSize> BuildLmrTable() {
+    std::array<std::array<int8_t, kLmrSize>, kLmrSize> table{};
+    for (int depth = 1; depth < kLmrSize; ++depth) {
+        for (int index = 1; index < kLmrSize; ++index) {
+            const double r = 0.5 + std::log(depth) * std::log(index) / 2.5;
+            table[depth][index] = static_cast<int8_t>(r);
+        }
+    }
+    return table;
+}
+
+const auto kLmrTable = BuildLmrTable();
+
 inline int Clamp(int x, int lo, int hi) {
     if (x < lo) {
         return lo;
@@ -32,7 +65,10 @@ inline int Clamp(int x, int lo, int hi) {
 }
 } // namespace
 
-SearchEngine::SearchEngine(TranspositionTable& tt) : tt_(tt) {
+SearchEngine::SearchEngine(TranspositionTable& tt)
+    : tt_(tt), stack_(kMaxSearchPly + 1), history_(std::make_unique<SearchHistory>()) {
+    history_->Clear();
+    root_moves_.reserve(MoveList::kMaxMoves);
 }
 
 void SearchEngine::SetStopCallback(bool (*is_stopped)()) noexcept {
@@ -75,11 +111,72 @@ int SearchEngine::ScoreFromTT(int score, int halfmove) noexcept {
     }
 }
 
+void SearchEngine::SetSignals(SearchSignals* signals) noexcept {
+    signals_ = signals;
+}
+
 bool SearchEngine::IsTimeUp() const noexcept {
     if (is_stopped_ && is_stopped_()) {
         return true;
     }
-    return false;
+    return aborted_;
+}
+
+void SearchEngine::PollSignals() noexcept {
+    if (signals_ != nullptr) {
+        if (signals_->stop.load(std::memory_order_relaxed)) {
+            aborted_ = true;
+            return;
+        }
+
+        // Ponderhit: the same search goes on as a normal timed search (tree, TT and history kept)
+        if (pondering_ && signals_->ponderhit.load(std::memory_order_relaxed)) {
+            pondering_ = false;
+            if (limits_.time_limit_ms > 0) {
+                has_deadline_ = true;
+                deadline_ = Clock::now() + std::chrono::milliseconds(limits_.time_limit_ms);
+            }
+        }
+    }
+
+    // The first iteration always completes so that a best move exists
+    if (has_deadline_ && !pondering_ && root_depth_ > 1 && Clock::now() >= deadline_) {
+        aborted_ = true;
+    }
+}
+
+// Node's PV row becomes the move followed by the child's row
+void SearchEngine::UpdatePv(int halfmove, const Move& move) noexcept {
+    SearchStackEntry& node = stack_[halfmove];
+    const SearchStackEntry& child = stack_[halfmove + 1];
+
+    node.pv[0] = move;
+    int length = 1;
+    for (int i = 0; i < child.pv_length && length < kMaxSearchPly; ++i) {
+        node.pv[length++] = child.pv[i];
+    }
+    node.pv_length = length;
+}
+
+// Selection step: brings the best-scored remaining move to from_index
+void SearchEngine::PickNextMove(SearchStackEntry& entry, int from_index, int count) noexcept {
+    int best = from_index;
+    for (int i = from_index + 1; i < count; ++i) {
+        if (entry.scores[i] > entry.scores[best]) {
+            best = i;
+        }
+    }
+
+    if (best != from_index) {
+        std::swap(entry.moves[best], entry.moves[from_index]);
+        std::swap(entry.scores[best], entry.scores[from_index]);
+    }
+}
+
+int SearchEngine::LmrReduction(int depth, int move_index) noexcept {
+    depth      = Clamp(depth, 0, kLmrSize - 1);
+    move_index = Clamp(move_index, 0, kLmrSize - 1);
+    return kLmrTable[depth][move_index];
 }
 
 void SearchEngine::ResetCutoffKeys() noexcept {
@@ -89,61 +186,282 @@ void SearchEngine::ResetCutoffKeys() noexcept {
     }
 }
 
+bool SearchEngine::IsRootExcluded(const Move& m) const noexcept {
+    for (int i = 0; i < root_excluded_count_; ++i) {
+        if (SameMove(m, root_excluded_[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<RootMove>& SearchEngine::GetRootMoves() const noexcept {
+    return root_moves_;
+}
+
+void SearchEngine::InitRootMoves(const Position& root) {
+    MoveList legal;
+    LegalMoveGen::Generate(root, root.IsWhiteToMove() ? Side::White : Side::Black, legal);
+
+    root_moves_.clear();
+    for (uint32_t i = 0; i < legal.GetSize(); ++i) {
+        RootMove rm{};
+        rm.move = legal[i];
+        rm.score = -kInfinity;
+        rm.previous_score = -kInfinity;
+        root_moves_.push_back(rm);
+    }
+}
+
+RootMove* SearchEngine::FindRootMove(const Move& m) noexcept {
+    for (RootMove& rm : root_moves_) {
+        if (SameMove(rm.move, m)) {
+            return &rm;
+        }
+    }
+    return nullptr;
+}
+
+// Stable insertion sort of root_moves_[from_index..]: score, then previous score, then nodes;
+// equal keys keep the previous rank (at most kMaxMoves entries, and no temporary buffer)
+void SearchEngine::SortRootMoves(int from_index) noexcept {
+    const auto better = [](const RootMove& a, const RootMove& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+
+        if (a.previous_score != b.previous_score) {
+            return a.previous_score > b.previous_score;
+        }
+        return a.nodes > b.nodes;
+    };
+
+    const int n = static_cast<int>(root_moves_.size());
+    for (int i = from_index + 1; i < n; ++i) {
+        for (int j = i; j > from_index && better(root_moves_[j], root_moves_[j - 1]); --j) {
+            std::swap(root_moves_[j], root_moves_[j - 1]);
+        }
+    }
+}
+
+// Moves with an exact score in this or the previous iteration (PV and MultiPV lines) go first,
+// in root list order; the failed-low rest keeps the normal ordering scores
+void SearchEngine::OrderRootMoves(SearchStackEntry& entry) const noexcept {
+    const auto IsRanked = [](const RootMove& rm) {
+        return rm.score > -kInfinity || rm.previous_score > -kInfinity;
+    };
+
+    const int n = entry.moves.GetSize();
+    const int root_move_count = static_cast<int>(root_moves_.size());
+    for (int i = 0; i < n; ++i) {
+        for (int rank = 0; rank < root_move_count && IsRanked(root_moves_[rank]); ++rank) {
+            if (SameMove(entry.moves[i], root_moves_[rank].move)) {
+                entry.scores[i] = kRootOrderScore - rank;
+                break;
+            }
+        }
+    }
+}
+
+double SearchEngine::BestMoveNodeShare() const noexcept {
+    if (root_moves_.empty()) {
+        return 0.0;
+    }
+
+    int64_t total = 0;
+    for (const RootMove& rm : root_moves_) {
+        total += rm.nodes;
+    }
+    return total > 0 ? static_cast<double>(root_moves_[0].nodes) / total : 0.0;
+}
+
+MoveOrdering::Context SearchEngine::MakeOrderingContext(int halfmove, Side stm, const Move& tt_move) const noexcept {
+    MoveOrdering::Context ctx{};
+    ctx.tt_move      = tt_move;
+    ctx.cutoff1      = cutoff_keys_[halfmove][0];
+    ctx.cutoff2      = cutoff_keys_[halfmove][1];
+    ctx.history      = history_.get();
+    ctx.side_to_move = stm;
+
+    // Null moves and the root leave the corresponding slots empty
+    if (halfmove >= 1) {
+        const Move& previous = stack_[halfmove - 1].current_move;
+        ctx.countermove     = history_->GetCountermove(previous);
+        ctx.continuation[0] = history_->GetContinuation(previous);
+    }
+    if (halfmove >= 2) {
+        ctx.continuation[1] = history_->GetContinuation(stack_[halfmove - 2].current_move);
+    }
+
+    return ctx;
+}
+
+void SearchEngine::UpdateHistories(int halfmove, Side stm, const Move& best, bool best_is_simple, int depth) noexcept {
+    SearchStackEntry& entry = stack_[halfmove];
+    const int bonus = SearchHistory::Bonus(depth);
+
+    SearchHistory::PieceToHistory* cont1 = nullptr;
+    SearchHistory::PieceToHistory* cont2 = nullptr;
+    if (halfmove >= 1) {
+        cont1 = history_->GetContinuation(stack_[halfmove - 1].current_move);
+    }
+    if (halfmove >= 2) {
+        cont2 = history_->GetContinuation(stack_[halfmove - 2].current_move);
+    }
+
+    if (best_is_simple) {
+        history_->UpdateButterfly(stm, best, bonus);
+        SearchHistory::UpdateContinuation(cont1, best, bonus);
+        SearchHistory::UpdateContinuation(cont2, best, bonus);
+
+        if (halfmove >= 1) {
+            history_->SetCountermove(stack_[halfmove - 1].current_move, best);
+        }
+
+        for (int i = 0; i < entry.quiet_count; ++i) {
+            const Move& q = entry.quiets_tried[i];
+            history_->UpdateButterfly(stm, q, -bonus);
+            SearchHistory::UpdateContinuation(cont1, q, -bonus);
+            SearchHistory::UpdateContinuation(cont2, q, -bonus);
+        }
+    }
+    else if (best.GetDefenderType() != Move::None || best.GetFlag() == Move::Flag::EnPassantCapture) {
+        history_->UpdateCapture(best, bonus);
+    }
+
+    // Captures that failed to cut off lose credit either way
+    for (int i = 0; i < entry.capture_count; ++i) {
+        history_->UpdateCapture(entry.captures_tried[i], -bonus);
+    }
+}
+
+void SearchEngine::FlushTTCounters() noexcept {
+    tt_.AddCounters(tt_counters_);
+    tt_counters_ = TranspositionTable::Counters{};
+}
+
 SearchResult SearchEngine::Search(Position& root, const SearchLimits& limits) {
     // Reset search state
     nodes_ = 0;
+    stats_ = SearchStats{};
+    tt_counters_ = TranspositionTable::Counters{};
+    tt_.NewSearch();
     limits_ = limits;
     ResetCutoffKeys();
+    root_excluded_count_ = 0;
+    InitRootMoves(root);
+
+    // The clock runs from now, or from the ponderhit when pondering
+    aborted_ = false;
+    root_depth_ = 0;
+    pondering_ = limits.ponder;
+    has_deadline_ = !pondering_ && limits.time_limit_ms > 0;
+    deadline_ = Clock::now() + std::chrono::milliseconds(limits.time_limit_ms);
 
     SearchResult result{};
 
-    // Aspiration window seeds
-    int alpha = -kInfinity;
-    int beta  = +kInfinity;
-    int prev_score = 0;
+    const int max_depth = std::min(limits.max_depth, kMaxSearchPly - 1);
+
+    // MultiPV: never ask for more lines than there are legal root moves
+    const int root_move_count = static_cast<int>(root_moves_.size());
+    const int line_target = std::max(1, std::min(Clamp(limits.multi_pv, 1, kMaxMultiPv), root_move_count));
 
-    const int max_depth = limits.max_depth;
+    // Scores of the previous iteration's lines centre the aspiration windows of the next one
+    int prev_scores[kMaxMultiPv]{};
 
     // Iterative deepening loop
+    bool stopped = false;
     for (int depth = 1; depth <= max_depth; ++depth) {
-        // Aspiration window around previous score (tighter as depth grows)
-        int window = (depth <= 4) ? 25 : 15;
-        alpha = Clamp(prev_score - window, -kInfinity, kInfinity);
-        beta  = Clamp(prev_score + window, -kInfinity, kInfinity);
-
-        // Main alpha-beta search for the current depth
-        PvLine pv{};
-        int score = AlphaBeta(root, depth, alpha, beta, /*halfmove=*/0, pv);
-        if (IsTimeUp()) {
+        root_depth_ = depth;
+
+        PollSignals();
+        if (aborted_) {
             break;
         }
 
-        // Aspiration fail → re-search with full window
-        if (score <= alpha || score >= beta) {
-            alpha = -kInfinity;
-            beta  = +kInfinity;
-            pv.length = 0;
-            score = AlphaBeta(root, depth, alpha, beta, 0, pv);
+        IterationStats& iteration = stats_.iterations[depth];
+        const int64_t iteration_start = nodes_;
 
-            if (IsTimeUp()) {
+        // Scores and node counts are rebuilt by this iteration; the old ones become tie-breakers
+        for (int i = 0; i < root_move_count; ++i) {
+            RootMove& rm = root_moves_[i];
+            rm.previous_score = rm.score;
+            rm.previous_rank = i;
+            rm.score = -kInfinity;
+            rm.nodes = 0;
+        }
+
+        // One root pass per line: every pass excludes the root moves of the lines found before it
+        // and reuses the TT filled by the earlier passes
+        PvLine lines[kMaxMultiPv];
+        int line_count = 0;
+        root_excluded_count_ = 0;
+
+        for (int pv_index = 0; pv_index < line_target; ++pv_index) {
+            const int score = AspirationSearch(root, depth, prev_scores[pv_index], iteration, stopped);
+            if (stopped) {
                 break;
             }
+
+            const SearchStackEntry& root_entry = stack_[0];
+            if (root_entry.pv_length == 0 && pv_index > 0) {
+                break;
+            }
+
+            PvLine& line = lines[line_count++];
+            line.score_cp = score;
+            line.length = root_entry.pv_length;
+            std::copy(root_entry.pv, root_entry.pv + root_entry.pv_length, line.moves);
+
+            if (root_entry.pv_length == 0) {
+                break;
+            }
+            root_excluded_[root_excluded_count_++] = root_entry.pv[0];
+        }
+        root_excluded_count_ = 0;
+
+        iteration.nodes = nodes_ - iteration_start;
+        FlushTTCounters();
+        stats_.fail_highs     += iteration.fail_highs;
+        stats_.fail_lows      += iteration.fail_lows;
+        stats_.research_nodes += iteration.research_nodes;
+
+        if (stopped) {
+            break;
+        }
+
+        // Later passes may still beat earlier ones after search instability; keep lines best first
+        // (insertion sort: stable, at most kMaxMultiPv lines, and no temporary buffer)
+        for (int i = 1; i < line_count; ++i) {
+            for (int j = i; j > 0 && lines[j].score_cp > lines[j - 1].score_cp; --j) {
+                std::swap(lines[j], lines[j - 1]);
+            }
+        }
+
+        for (int i = 0; i < line_count; ++i) {
+            prev_scores[i] = lines[i].score_cp;
         }
 
+        // The next iteration searches the root in this order
+        SortRootMoves(0);
+
         // Iteration result
-        prev_score = score;
         result.depth = depth;
-        result.score_cp = score;
+        result.score_cp = lines[0].score_cp;
 
-        if (pv.length > 0) {
-            result.best_move = pv.moves[0];
+        if (lines[0].length > 0) {
+            result.best_move = lines[0].moves[0];
         }
 
-        result.pv = pv;
+        result.pv = lines[0];
+        std::copy(lines, lines + line_count, result.lines);
+        result.line_count = line_count;
         result.nodes = nodes_;
+        result.stats = stats_;
+        result.best_move_node_share = BestMoveNodeShare();
 
         // Early stops: mate found or node limit reached
-        if (IsMateScore(score)) {
+        if (IsMateScore(result.score_cp)) {
             break;
         }
 
@@ -152,21 +470,95 @@ SearchResult SearchEngine::Search(Position& root, const SearchLimits& limits) {
             break;
         }
 
-        int from = static_cast<int>(result.best_move.GetFrom());
-        int to = static_cast<int>(result.best_move.GetTo());
+        // Soft node budget (not while pondering): a best move that takes most of the root nodes is unlikely to change
+        if (limits_.soft_nodes_limit > 0 && !pondering_) {
+            const double scale = 1.5 - result.best_move_node_share;
+            if (static_cast<double>(nodes_) >= static_cast<double>(limits_.soft_nodes_limit) * scale) {
+                break;
+            }
+        }
 
-        std::cout << "search depth: " << depth << "; score cp: " << result.score_cp << "; best move: "
-                  << from << "-" << to << std::endl;
+        for (int i = 0; i < line_count; ++i) {
+            const int from = lines[i].length > 0 ? static_cast<int>(lines[i].moves[0].GetFrom()) : Move::None;
+            const int to = lines[i].length > 0 ? static_cast<int>(lines[i].moves[0].GetTo()) : Move::None;
+
+            std::cout << "search depth: " << depth;
+            if (line_target > 1) {
+                std::cout << "; multipv: " << (i + 1);
+            }
+            std::cout << "; score cp: " << lines[i].score_cp << "; best move: " << from << "-" << to
+                      << "; fail high/low: " << iteration.fail_highs << "/" << iteration.fail_lows << std::endl;
+        }
     }
 
+    // Counters include the interrupted iteration
+    result.stats = stats_;
     return result;
 }
 
-int SearchEngine::Quiescence(Position& pos, int alpha, int beta, int halfmove, PvLine& pv) {
+int SearchEngine::AspirationSearch(Position& root, int depth, int prev_score, IterationStats& iteration, bool& stopped) {
+    // Aspiration window around the previous score; the first iterations have no stable score to
+    // centre on and use the full window
+    int delta = kAspirationDelta;
+    int alpha = -kInfinity;
+    int beta  = +kInfinity;
+    if (depth >= kAspirationDepth) {
+        alpha = Clamp(prev_score - delta, -kInfinity, kInfinity);
+        beta  = Clamp(prev_score + delta, -kInfinity, kInfinity);
+    }
+
+    // On a failed window the failed bound moves out by a delta that grows geometrically, until it
+    // reaches the full window; after a fail-low beta also comes down to the middle of the old window,
+    // as the true score is below it
+    int failures = 0;
+    while (true) {
+        const int64_t attempt_start = nodes_;
+
+        const int score = AlphaBeta(root, depth, alpha, beta, /*halfmove=*/0);
+
+        // A re-search starts with the move that failed high; moves of earlier MultiPV lines stay on top
+        SortRootMoves(root_excluded_count_);
+
+        if (failures > 0) {
+            iteration.research_nodes += nodes_ - attempt_start;
+        }
+
+        if (IsTimeUp()) {
+            stopped = true;
+            return score;
+        }
+
+        if (score <= alpha && alpha > -kInfinity) {
+            ++iteration.fail_lows;
+            beta  = (alpha + beta) / 2;
+            alpha = Clamp(score - delta, -kInfinity, kInfinity);
+        }
+        else if (score >= beta && beta < kInfinity) {
+            ++iteration.fail_highs;
+            beta = Clamp(score + delta, -kInfinity, kInfinity);
+        }
+        else {
+            return score;
+        }
+
+        ++failures;
+        delta += delta / 2;
+    }
+}
+
+int SearchEngine::Quiescence(Position& pos, int alpha, int beta, int halfmove, int depth) {
     if (!IncreaseNodeCounter()) {
         return 0;
     }
 
+    SearchStackEntry& entry = stack_[halfmove];
+    entry.pv_length = 0;
+
+    // Search stack is exhausted: fall back to the static evaluation
+    if (halfmove >= kMaxSearchPly - 1) {
+        return pos.IsWhiteToMove() ? Evaluation::Evaluate(pos) : -Evaluation::Evaluate(pos);
+    }
+
     const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
     const uint8_t ksq = BOp::BitScanForward(pos.GetPieces().GetPieceBitboard(stm, PieceType::King));
     const bool in_check = PsLegalMaskGen::SquareInDanger(pos.GetPieces(), ksq, stm);
@@ -187,33 +579,35 @@ int SearchEngine::Quiescence(Position& pos, int alpha, int beta, int halfmove, P
         }
     }
 
-    MoveList ml;
-    LegalMoveGen::Generate(pos, stm, ml, /*only_captures=*/!in_check);
+    entry.static_eval = stand_pat;
 
-    const size_t n = ml.GetSize();
+    MoveList& ml = entry.moves;
+    LegalMoveGen::Generate(pos, stm, in_check ? GenType::Evasions : GenType::Captures, ml);
 
-    MoveOrdering::Context qctx{};
-    qctx.tt_move      = Move{};
-    qctx.cutoff1      = 0;
-    qctx.cutoff2      = 0;
-    qctx.history      = &history_;
-    qctx.side_to_move = stm;
+    // First quiescence ply also tries quiet checks
+    if (!in_check && depth == 0) {
+        LegalMoveGen::GenerateQuietChecks(pos, stm, ml);
+    }
 
-    std::vector<int> scores(n);
-    std::vector<size_t> order(n);
+    const int n = ml.GetSize();
 
-    for (size_t i = 0; i < n; ++i) {
-        order[i]  = i;
-        scores[i] = MoveOrdering::Score(ml[i], pos.GetPieces(), qctx);
+    // No evasion: checkmate
+    if (in_check && n == 0) {
+        return -kMateScore + halfmove;
     }
 
-    std::sort(order.begin(), order.end(), [&](size_t ia, size_t ib) {
-        return scores[ia] > scores[ib];
-    });
+    MoveOrdering::Context qctx = MakeOrderingContext(halfmove, stm, Move{});
+    qctx.cutoff1 = 0;
+    qctx.cutoff2 = 0;
 
-    PvLine best_child{};
-    for (size_t oi = 0; oi < order.size(); ++oi) {
-        const Move& m = ml[order[oi]];
+    for (int i = 0; i < n; ++i) {
+        entry.scores[i] = MoveOrdering::Score(ml[i], pos.GetPieces(), qctx);
+    }
+
+    for (int oi = 0; oi < n; ++oi) {
+        PickNextMove(entry, oi, n);
+        const Move m = ml[oi];
+        bool quiet_check = false;
 
         // Out of check: delta and SEE filter for captures
         if (!in_check) {
@@ -243,17 +637,26 @@ int SearchEngine::Quiescence(Position& pos, int alpha, int beta, int halfmove, P
                     }
                 }
             }
-            // In quiet quiescence node without check we ignore quiet moves
-            else {
+            // Quiet moves come only from the quiet-check generator on the first ply
+            else if (depth < 0 || is_promo) {
                 continue;
             }
+            else {
+                quiet_check = true;
+            }
         }
 
         Position::Undo u{};
+        entry.current_move = m;
         pos.ApplyMove(m, u);
 
-        PvLine child{};
-        const int score = -Quiescence(pos, -beta, -alpha, halfmove + 1, child);
+        // Quiet check that simply hangs the checking piece is not worth searching
+        if (quiet_check && StaticExchangeEvaluation::On(pos.GetPieces(), m.GetTo(), stm) < 0) {
+            pos.UndoMove(m, u);
+            continue;
+        }
+
+        const int score = -Quiescence(pos, -beta, -alpha, halfmove + 1, depth - 1);
 
         pos.UndoMove(m, u);
 
@@ -263,128 +666,255 @@ int SearchEngine::Quiescence(Position& pos, int alpha, int beta, int halfmove, P
 
         if (score > alpha) {
             alpha = score;
-            best_child = child;
-            pv.length = 0;
-
-            if (pv.length < 128) {
-                pv.moves[pv.length++] = m;
-            }
-
-            for (int i = 0; i < best_child.length && pv.length < 128; ++i) {
-                pv.moves[pv.length++] = best_child.moves[i];
-            }
+            UpdatePv(halfmove, m);
         }
     }
 
     return alpha;
 }
 
-int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int halfmove, PvLine& pv) {
+int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int halfmove) {
     // Node or time limit check
     if (!IncreaseNodeCounter()) {
         return 0;
     }
 
-    // Fast draw by repetition or fifty-move rule
-    if (pos.IsThreefoldRepetition() || pos.IsFiftyMoveRuleDraw()) {
+    SearchStackEntry& entry = stack_[halfmove];
+    entry.pv_length = 0;
+
+    // Singular verification search: same node with the TT move excluded; a MultiPV pass is the
+    // root with the moves of the lines already found excluded
+    const Move excluded = entry.excluded_move;
+    const bool root_exclusions = (halfmove == 0 && root_excluded_count_ > 0);
+    const bool excluded_search = (excluded.GetFrom() != Move::None) || root_exclusions;
+
+    // Fast draw by repetition inside the search path or fifty-move rule
+    if (halfmove > 0 && (pos.IsRepetition(halfmove) || pos.IsFiftyMoveRuleDraw())) {
         return 0;
     }
 
+    // The side to move can force a repetition in one move: the draw score is a lower bound
+    if (halfmove > 0 && alpha < 0 && pos.HasUpcomingRepetition(halfmove)) {
+        alpha = 0;
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+
     // Leaf node goes to quiescence search
-    if (depth <= 0) {
-        return Quiescence(pos, alpha, beta, halfmove, pv);
+    if (depth <= 0 || halfmove >= kMaxSearchPly - 1) {
+        return Quiescence(pos, alpha, beta, halfmove);
     }
 
     // Save original alpha for correct bound type when writing to TT
     const int alpha_orig = alpha;
 
-    // Transposition table probe
+    // Transposition table probe (a verification search must not take the cutoff of the full node)
     const uint64_t key = pos.GetZobristKey();
     int  tt_score = 0;
     Move tt_move{};
-    if (kUseTT == true) {
-        if (tt_.Probe(key, depth, alpha, beta, tt_score, tt_move)) {
+    if (kUseTT == true && !excluded_search) {
+        // The root only takes the move: a cutoff there would leave no PV and no best move
+        if (tt_.Probe(key, depth, alpha, beta, tt_score, tt_move, &tt_counters_) && halfmove > 0) {
             return ScoreFromTT(tt_score, halfmove);
         }
     }
 
+    const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
+    const uint8_t ksq = BOp::BitScanForward(pos.GetPieces().GetPieceBitboard(stm, PieceType::King));
+    const bool in_check = PsLegalMaskGen::SquareInDanger(pos.GetPieces(), ksq, stm);
+    const bool is_pv = (beta - alpha > 1);
+
     // Static evaluation of the node (for futility and razoring)
     // Evaluate returns score from the side of White
     const int static_eval = pos.IsWhiteToMove() ? Evaluation::Evaluate(pos) : -Evaluation::Evaluate(pos);
 
+    // Improving: static eval is better than two halfmoves ago (same side to move)
+    const bool improving = !in_check && halfmove >= 2 && static_eval > stack_[halfmove - 2].static_eval;
+
     // Razoring at depth 1
-    if (depth == 1 && static_eval + 150 <= alpha) {
-        PvLine qpv{};
-        const int q = Quiescence(pos, alpha - 1, alpha, halfmove, qpv);
+    if (!excluded_search && depth == 1 && static_eval + 150 <= alpha) {
+        const int q = Quiescence(pos, alpha - 1, alpha, halfmove);
         if (q <= alpha) {
             return q;
         }
     }
 
-    // Null-move pruning (only if not in check and there are non-pawn pieces)
-    {
-        const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
-        const uint8_t ksq = BOp::BitScanForward(pos.GetPieces().GetPieceBitboard(stm, PieceType::King));
-        const bool in_check = PsLegalMaskGen::SquareInDanger(pos.GetPieces(), ksq, stm);
+    // Razoring may have used this halfmove's entry
+    entry.static_eval = static_eval;
+    entry.pv_length   = 0;
+
+    // Reverse futility: at shallow non-PV nodes a static eval far above beta is taken as a cutoff
+    if (!is_pv && !in_check && !excluded_search && depth <= kReverseFutilityDepth && !IsMateScore(beta)) {
+        const int margin = kReverseFutilityMargin * (depth - (improving ? 1 : 0));
+        if (static_eval - margin >= beta) {
+            return static_eval - margin;
+        }
+    }
+
+    // Null-move pruning (only if not in check, eval is above beta and there are non-pawn pieces).
+    // R grows with depth and with the eval surplus; in pawn endgames with at most one piece left
+    // zugzwang is likely, so a fail-high is verified by a normal reduced search without null moves
+    if (!in_check && !excluded_search && !entry.null_move_disabled && depth >= 3 && static_eval >= beta) {
+        const Bitboard non_pawn =
+            pos.GetPieces().GetPieceBitboard(stm, PieceType::Knight) |
+            pos.GetPieces().GetPieceBitboard(stm, PieceType::Bishop) |
+            pos.GetPieces().GetPieceBitboard(stm, PieceType::Rook)   |
+            pos.GetPieces().GetPieceBitboard(stm, PieceType::Queen);
+
+        if (non_pawn) {
+            const int R = 2 + depth / 4 + std::min((static_eval - beta) / 200, 2);
+            if (depth - 1 - R > 0) {
+                tt_.Prefetch(key ^ ZobristHash::BlackToMoveKey());
+            }
 
-        if (!in_check && depth >= 3) {
-            Bitboard non_pawn =
-                pos.GetPieces().GetPieceBitboard(stm, PieceType::Knight) |
-                pos.GetPieces().GetPieceBitboard(stm, PieceType::Bishop) |
-                pos.GetPieces().GetPieceBitboard(stm, PieceType::Rook)   |
-                pos.GetPieces().GetPieceBitboard(stm, PieceType::Queen);
+            Position::NullUndo nu{};
+            entry.current_move = Move{};
+            pos.ApplyNullMove(nu);
 
-            if (non_pawn) {
-                Position::NullUndo nu{};
-                pos.ApplyNullMove(nu);
+            int nm_score = -AlphaBeta(pos, depth - 1 - R, -beta, -beta + 1, halfmove + 1);
 
-                PvLine dummy{};
-                const int R = 2;
-                const int nm_score = -AlphaBeta(pos, depth - 1 - R, -beta, -beta + 1, halfmove + 1, dummy);
+            pos.UndoNullMove(nu);
 
-                pos.UndoNullMove(nu);
+            if (nm_score >= beta) {
+                // Do not return unproven mate scores from a null-move search
+                if (nm_score >= kMateThreshold) {
+                    nm_score = beta;
+                }
 
-                if (nm_score >= beta) {
+                const bool zugzwang_prone = BOp::Count_1(non_pawn) <= 1;
+                if (!zugzwang_prone) {
                     return nm_score;
                 }
+
+                // Verification reuses this halfmove's entry before move generation
+                entry.null_move_disabled = true;
+                const int verified = AlphaBeta(pos, depth - 1 - R, beta - 1, beta, halfmove);
+                entry.null_move_disabled = false;
+                entry.static_eval = static_eval;
+                entry.pv_length = 0;
+
+                if (verified >= beta) {
+                    return nm_score;
+                }
+            }
+        }
+    }
+
+    // ProbCut: a capture that wins enough material (SEE) to beat beta by a margin, and still does so
+    // in quiescence and then in a reduced null-window search, makes the full search of this node
+    // very likely to fail high as well. Uses this halfmove's move list before full generation
+    const int probcut_beta = beta + kProbCutMargin;
+    if (!is_pv && !in_check && !excluded_search && depth >= kProbCutDepth && !IsMateScore(beta)) {
+        MoveList& captures = entry.moves;
+        LegalMoveGen::Generate(pos, stm, captures, /*only_captures=*/true);
+
+        for (int i = 0; i < captures.GetSize(); ++i) {
+            const Move m = captures[i];
+            if (m.GetDefenderType() == Move::None || IsPromotionFlag(m.GetFlag())) {
+                continue;
+            }
+            if (StaticExchangeEvaluation::Capture(pos.GetPieces(), m) < probcut_beta - static_eval) {
+                continue;
+            }
+
+            Position::Undo u{};
+            entry.current_move = m;
+            pos.ApplyMove(m, u);
+
+            int score = -Quiescence(pos, -probcut_beta, -probcut_beta + 1, halfmove + 1);
+            if (score >= probcut_beta) {
+                score = -AlphaBeta(pos, depth - kProbCutReduction, -probcut_beta, -probcut_beta + 1, halfmove + 1);
+            }
+
+            pos.UndoMove(m, u);
+
+            if (score >= probcut_beta) {
+                ++stats_.probcut_cutoffs;
+                return score;
+            }
+        }
+    }
+
+    // Internal iterative reduction: without a TT move the ordering is poor, so search shallower
+    // now and let the next iteration find this node with a best move stored. Never at the root,
+    // where it would search the whole iteration a ply shallower than the depth it reports
+    if (halfmove > 0 && tt_move.GetFrom() == Move::None && !in_check && !excluded_search && depth >= 4) {
+        depth -= 1;
+    }
+
+    // Singular extension: a TT move with a deep enough lower bound is verified by a reduced search
+    // of all other moves against a margin below its score; if they all fail low it gets extended.
+    // The verification reuses this halfmove's stack entry, so it runs before move generation.
+    bool tt_move_singular = false;
+    if (!excluded_search && halfmove > 0 && depth >= 6 && tt_move.GetFrom() != Move::None) {
+        TranspositionTable::Entry tt_entry{};
+        if (tt_.Lookup(key, tt_entry) && tt_entry.bound == TranspositionTable::Bound::Lower &&
+            tt_entry.depth >= depth - 3) {
+            const int tt_value = ScoreFromTT(tt_entry.score, halfmove);
+
+            if (!IsMateScore(tt_value)) {
+                const int singular_beta = tt_value - 2 * depth;
+
+                entry.excluded_move = tt_move;
+                const int score = AlphaBeta(pos, (depth - 1) / 2, singular_beta - 1, singular_beta, halfmove);
+                entry.excluded_move = Move{};
+                entry.pv_length = 0;
+
+                if (score < singular_beta) {
+                    tt_move_singular = true;
+                    ++stats_.singular_extensions;
+                }
+                // Multi-cut: even without the TT move the node fails high
+                else if (singular_beta >= beta) {
+                    return singular_beta;
+                }
             }
         }
     }
 
     // Full move generation
-    const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
-    MoveList ml;
-    LegalMoveGen::Generate(pos, stm, ml, /*only_captures=*/false);
+    MoveList& ml = entry.moves;
+    LegalMoveGen::Generate(pos, stm, in_check ? GenType::Evasions : GenType::All, ml);
 
     // Move ordering context (no move copying)
-    const size_t n = ml.GetSize();
+    const int n = ml.GetSize();
 
-    MoveOrdering::Context ctx{};
-    ctx.tt_move      = tt_move;
-    ctx.cutoff1      = cutoff_keys_[halfmove][0];
-    ctx.cutoff2      = cutoff_keys_[halfmove][1];
-    ctx.history      = &history_;
-    ctx.side_to_move = stm;
+    // No legal move: checkmate, scored by its distance from the root so the shortest mate wins, or stalemate
+    if (n == 0) {
+        const int score = in_check ? -kMateScore + halfmove : 0;
+        if (kUseTT == true && !excluded_search && !aborted_) {
+            tt_.Store(key, depth, ScoreToTT(score, halfmove), TranspositionTable::Bound::Exact, Move{}, &tt_counters_);
+        }
+        return score;
+    }
+
+    const MoveOrdering::Context ctx = MakeOrderingContext(halfmove, stm, tt_move);
+
+    for (int i = 0; i < n; ++i) {
+        entry.scores[i] = MoveOrdering::Score(ml[i], pos.GetPieces(), ctx);
+    }
 
-    std::vector<int> scores(n);
-    std::vector<size_t> order(n);
-    for (size_t i = 0; i < n; ++i) {
-        order[i]  = i;
-        scores[i] = MoveOrdering::Score(ml[i], pos.GetPieces(), ctx);
+    if (halfmove == 0 && root_depth_ > 1) {
+        OrderRootMoves(entry);
     }
-    std::sort(order.begin(), order.end(), [&](size_t ia, size_t ib) {
-        return scores[ia] > scores[ib];
-    });
 
     // Main loop with LMR, PVS and pruning
     Move   best_move{};
-    PvLine best_child{};
     int    best_score = -kInfinity;
 
+    entry.quiet_count   = 0;
+    entry.capture_count = 0;
+
     int move_index = 0;
-    for (size_t oi = 0; oi < order.size(); ++oi) {
+    for (int oi = 0; oi < n; ++oi) {
+        PickNextMove(entry, oi, n);
+        const Move m = ml[oi];
+
+        if (excluded_search && (SameMove(m, excluded) || (root_exclusions && IsRootExcluded(m)))) {
+            continue;
+        }
         ++move_index;
-        const Move& m = ml[order[oi]];
 
         const bool is_promo   = IsPromotionFlag(m.GetFlag());
         const bool is_capture = (m.GetDefenderType() != Move::None) ||
@@ -392,9 +922,7 @@ int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int h
         const bool is_simple  = !is_capture && !is_promo;
 
         // Check if this is the TT move
-        const bool is_tt = (m.GetFrom() == tt_move.GetFrom() &&
-                            m.GetTo()   == tt_move.GetTo()   &&
-                            m.GetFlag() == tt_move.GetFlag());
+        const bool is_tt = SameMove(m, tt_move);
         const bool is_first = (move_index == 1);
 
         // Pre-SEE for captures at shallow depths
@@ -403,8 +931,24 @@ int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int h
             see = StaticExchangeEvaluation::Capture(pos.GetPieces(), m);
         }
 
+        // Pruning candidates; whether the move gives check is only known after it is made, and a
+        // (safe) check is still searched
+        const bool futile = is_simple && depth <= 3 && !is_tt && !is_first &&
+                            static_eval + (depth == 1 ? 100 : depth == 2 ? 200 : 300) <= alpha;
+        const bool losing_capture = is_capture && !is_promo && depth <= 2 && !is_tt && !is_first && see < 0;
+        const bool late_quiet = is_simple && !is_tt && depth > 7 &&
+                                move_index > (3 + depth * depth) / (improving ? 1 : 2);
+
+        // The child probes the TT first thing: start loading its slot before making the move,
+        // unless the move is about to be pruned
+        if (depth > 1 && !futile && !losing_capture && !late_quiet) {
+            tt_.Prefetch(pos.KeyAfter(m));
+        }
+
         // Apply move
+        const int64_t move_nodes_start = nodes_;
         Position::Undo u{};
+        entry.current_move = m;
         pos.ApplyMove(m, u);
 
         // Check whether the move gives check (to avoid pruning such moves)
@@ -420,106 +964,120 @@ int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int h
         const bool safe_check = gives_check && (see_on_checker >= 0);
 
         // Futility pruning of quiet moves at shallow depths (if move is not a safe check)
-        if (!safe_check && is_simple && depth <= 3 && !is_tt && !is_first) {
-            const int margin = (depth == 1 ? 100 : depth == 2 ? 200 : 300);
-            if (static_eval + margin <= alpha) {
-                pos.UndoMove(m, u);
-                continue;
-            }
+        if (futile && !safe_check) {
+            pos.UndoMove(m, u);
+            continue;
         }
 
         // SEE-based pruning of obviously losing captures at shallow depths (if move is not check)
-        if (!gives_check && is_capture && !is_promo && depth <= 2 && !is_tt && !is_first) {
-            if (see < 0) {
-                pos.UndoMove(m, u);
-                continue;
-            }
+        if (losing_capture && !gives_check) {
+            pos.UndoMove(m, u);
+            continue;
         }
 
         // Late move pruning: very late quiet moves that are not checks and not TT moves
-        if (!safe_check && is_simple && !is_tt && depth > 7 && move_index >= lmr_base_index_ + 2) {
-            const int quiet_limit = 2 + (depth * depth) / 2;
-            if (move_index > quiet_limit) {
-                pos.UndoMove(m, u);
-                continue;
-            }
+        if (late_quiet && !safe_check) {
+            pos.UndoMove(m, u);
+            continue;
         }
 
-        const int new_depth = depth - 1;
+        // Check and singular extensions: one ply deeper, limited to twice the root depth
+        const int extension = ((safe_check || (is_tt && tt_move_singular)) && halfmove < 2 * root_depth_) ? 1 : 0;
+        const int new_depth = depth - 1 + extension;
 
         int score = 0;
-        PvLine child{};
 
-        // LMR for late quiet moves
-        if (is_simple && depth >= 3 && move_index >= lmr_base_index_) {
-            const int r = 1;
-            score = -AlphaBeta(pos, new_depth - r, -alpha - 1, -alpha, halfmove + 1, child);
+        // LMR for late quiet moves (checks are not reduced)
+        int r = 0;
+        if (is_simple && !gives_check && !is_tt && depth >= 3 && move_index > (is_pv ? 2 : 1)) {
+            const int history_score = history_->GetButterfly(stm, m) +
+                                      SearchHistory::ContinuationValue(ctx.continuation[0], m) +
+                                      SearchHistory::ContinuationValue(ctx.continuation[1], m);
+
+            r = LmrReduction(depth, move_index);
+            r -= is_pv ? 1 : 0;
+            r += (!improving && r > 0) ? 1 : 0;
+            r -= history_score / 8192;
+            r = Clamp(r, 0, new_depth - 1);
+        }
+
+        if (r > 0) {
+            score = -AlphaBeta(pos, new_depth - r, -alpha - 1, -alpha, halfmove + 1);
             if (score > alpha) {
-                score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1, child);
+                score = -AlphaBeta(pos, new_depth, -alpha - 1, -alpha, halfmove + 1);
+            }
+            if (score > alpha && score < beta) {
+                score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1);
             }
         }
         else {
             // PVS: first move searched with full window, others with zero window and optional re-search
             if (is_first) {
-                score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1, child);
+                score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1);
             }
             else {
-                score = -AlphaBeta(pos, new_depth, -alpha - 1, -alpha, halfmove + 1, child);
+                score = -AlphaBeta(pos, new_depth, -alpha - 1, -alpha, halfmove + 1);
                 if (score > alpha && score < beta) {
-                    score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1, child);
+                    score = -AlphaBeta(pos, new_depth, -beta, -alpha, halfmove + 1);
                 }
             }
         }
 
         pos.UndoMove(m, u);
 
+        // An aborted search returns garbage scores: leave before they reach the TT or the histories
+        if (aborted_) {
+            return 0;
+        }
+
+        // Root list: node count and score of the move; a fail-low only bounds it from above
+        if (halfmove == 0) {
+            if (RootMove* rm = FindRootMove(m)) {
+                rm->nodes += nodes_ - move_nodes_start;
+                rm->score = (score > alpha) ? score : -kInfinity;
+            }
+        }
+
         // Update best score and best move
         if (score > best_score) {
             best_score  = score;
-            best_child  = child;
             best_move   = m;
         }
 
         // Beta cutoff: update history and cutoff moves, store in TT and return
         if (best_score >= beta) {
+            ++stats_.beta_cutoffs;
+            if (is_first) {
+                ++stats_.first_move_cutoffs;
+            }
+
             if (is_simple) {
                 const uint16_t key16 = FromToKey(m);
                 if (cutoff_keys_[halfmove][0] != key16) {
                     cutoff_keys_[halfmove][1] = cutoff_keys_[halfmove][0];
                     cutoff_keys_[halfmove][0] = key16;
                 }
-
-                // After undo, side to move is restored to the original one
-                const int side_index = pos.IsWhiteToMove() ? 1 : 0;
-                const int from = static_cast<int>(m.GetFrom());
-                const int to   = static_cast<int>(m.GetTo());
-                history_[side_index][from][to] += depth * depth;
-
-                if (history_[side_index][from][to] > 32767) {
-                    for (int s = 0; s < 2; ++s) {
-                        for (int f = 0; f < 64; ++f) {
-                            for (int t = 0; t < 64; ++t) {
-                                history_[s][f][t] /= 2;
-                            }
-                        }
-                    }
-                }
             }
+            UpdateHistories(halfmove, stm, m, is_simple, depth);
 
-            if (kUseTT == true) {
-                tt_.Store(key, depth, ScoreToTT(best_score, halfmove), TranspositionTable::Bound::Lower, best_move);
+            if (kUseTT == true && !excluded_search && !aborted_) {
+                tt_.Store(key, depth, ScoreToTT(best_score, halfmove), TranspositionTable::Bound::Lower, best_move, &tt_counters_);
             }
             return best_score;
         }
 
-        // Alpha improvement: update principal variation
+        // Remember searched moves for history maluses on a later cutoff
+        if (is_simple && entry.quiet_count < 64) {
+            entry.quiets_tried[entry.quiet_count++] = m;
+        }
+        else if (is_capture && !is_promo && entry.capture_count < 32) {
+            entry.captures_tried[entry.capture_count++] = m;
+        }
+
+        // Alpha improvement: update principal variation from the child's row
         if (best_score > alpha) {
             alpha = best_score;
-            pv.length = 0;
-            pv.moves[pv.length++] = best_move;
-            for (int i = 0; i < best_child.length; ++i) {
-                pv.moves[pv.length++] = best_child.moves[i];
-            }
+            UpdatePv(halfmove, best_move);
         }
     }
 
@@ -527,6 +1085,8 @@ int SearchEngine::AlphaBeta(Position& pos, int depth, int alpha, int beta, int h
     const auto bnd = (best_score <= alpha_orig)
                          ? TranspositionTable::Bound::Upper
                          : TranspositionTable::Bound::Exact;
-    tt_.Store(key, depth, ScoreToTT(best_score, halfmove), bnd, best_move);
+    if (!excluded_search && !aborted_) {
+        tt_.Store(key, depth, ScoreToTT(best_score, halfmove), bnd, best_move, &tt_counters_);
+    }
     return best_score;
 }
@@ -1,24 +1,118 @@
 /************
 * Search — iterative deepening with alpha-beta, principal variation, transposition table and quiescence search
-* It uses move ordering (tt, promotions, captures, cutoff moves, history), late move reductions,
+* It uses move ordering (tt, promotions, captures, cutoff moves, countermoves, history tables), table-driven
+* late move reductions adjusted by history, PV-node status and improving static eval, singular extensions,
+* reverse futility, adaptive null-move pruning with zugzwang verification, ProbCut, MultiPV root passes,
+* a root move list kept across iterations (ordering, per-move node counts),
 * Basic futility/razoring and mate-score normalization; terminology: cutoff moves, simple moves, halfmove
+* Per-halfmove state (move list, scores, static eval, current move, PV row) lives in a preallocated
+* search stack, so a node performs no heap allocations and PVs are built in place.
 ************/
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "../board_state/position.h"
 #include "../board_state/move.h"
+#include "../move_generation/move_list.h"
 #include "transposition_table.h"
+#include "move_ordering.h"
+#include "search_history.h"
+
+constexpr int kMaxSearchPly = 128;
+constexpr int kMaxMultiPv = 8;
 
 struct SearchLimits {
     int max_depth = 64;
     int64_t nodes_limit = 0; // 0 = unlimited
+    int multi_pv = 1;        // number of best root moves to report, clamped to [1, kMaxMultiPv]
+
+    // 0 = none; no new iteration starts past this budget, scaled by how much the best move
+    // dominates the root node distribution (from 0.5x when it takes every node to 1.5x)
+    int64_t soft_nodes_limit = 0;
+
+    int time_limit_ms = 0; // 0 = unlimited; counted from the start, or from the ponderhit when pondering
+    bool ponder = false;   // search the expected reply with the clock stopped until ponderhit or stop
+};
+
+// Requests raised by another thread while a search runs; owned and reset by the caller
+struct SearchSignals {
+    std::atomic<bool> stop{false};      // abort and return the last completed iteration
+    std::atomic<bool> ponderhit{false}; // the ponder move was played: start the clock, keep searching
 };
 
 struct PvLine {
-    Move moves[128];
+    Move moves[kMaxSearchPly];
     int length = 0;
+    int score_cp = 0;
+};
+
+// Search state of one halfmove; rows of the triangular PV table are indexed by halfmove too
+struct SearchStackEntry {
+    MoveList moves;
+    int scores[MoveList::kMaxMoves]{};
+    int static_eval = 0;
+    Move current_move{};
+    Move excluded_move{}; // set while a singular-extension verification search runs at this halfmove
+    bool null_move_disabled = false; // set while a null-move verification search runs at this halfmove
+
+    // Moves searched without a cutoff, penalised in history when a later move cuts off
+    Move quiets_tried[64];
+    int quiet_count = 0;
+    Move captures_tried[32];
+    int capture_count = 0;
+
+    Move pv[kMaxSearchPly];
+    int pv_length = 0;
+};
+
+// Root move kept across iterative-deepening iterations: ordering keys and node distribution
+struct RootMove {
+    Move move{};
+    int score = 0;          // latest search of the move; the lowest score when it failed low
+    int previous_score = 0; // score at the end of the previous iteration
+    int previous_rank = 0;  // position in the root list at the end of the previous iteration
+    int64_t nodes = 0;      // nodes spent below the move in the current iteration
+};
+
+// Aspiration window outcome of one iterative-deepening iteration
+struct IterationStats {
+    int fail_highs = 0;
+    int fail_lows = 0;
+    int64_t nodes = 0;          // all nodes of the iteration
+    int64_t research_nodes = 0; // nodes spent re-searching after a failed window
+};
+
+// Counters collected over one Search() call
+struct SearchStats {
+    int64_t beta_cutoffs = 0;       // fail-high nodes in AlphaBeta
+    int64_t first_move_cutoffs = 0; // ... where the first searched move already failed high
+    int64_t singular_extensions = 0; // TT moves extended because every alternative failed low
+    int64_t probcut_cutoffs = 0;     // nodes cut by a capture that held above beta + margin
+
+    // Aspiration windows: totals over all iterations and per-iteration detail indexed by depth
+    int64_t fail_highs = 0;
+    int64_t fail_lows = 0;
+    int64_t research_nodes = 0;
+    IterationStats iterations[kMaxSearchPly]{};
+
+    // Share of cutoffs produced by the first move (move-ordering quality), 0 when no cutoffs
+    double FirstMoveCutoffRate() const noexcept {
+        return beta_cutoffs > 0 ? static_cast<double>(first_move_cutoffs) / beta_cutoffs : 0.0;
+    }
+
+    // Share of iteration nodes spent in aspiration re-searches, 0 when nothing was searched
+    double ResearchOverhead() const noexcept {
+        int64_t nodes = 0;
+        for (const IterationStats& it : iterations) {
+            nodes += it.nodes;
+        }
+        return nodes > 0 ? static_cast<double>(research_nodes) / nodes : 0.0;
+    }
 };
 
 struct SearchResult {
@@ -27,6 +121,12 @@ struct SearchResult {
     int depth = 0;
     int64_t nodes = 0;
     PvLine pv;
+    SearchStats stats;
+    double best_move_node_share = 0.0; // share of the last iteration's root nodes spent below best_move
+
+    // MultiPV: best root moves of the last completed iteration, ordered by score (lines[0] == pv)
+    PvLine lines[kMaxMultiPv];
+    int line_count = 0;
 };
 
 class SearchEngine {
@@ -34,16 +134,29 @@ public:
     explicit SearchEngine(TranspositionTable& tt);
 
     void SetStopCallback(bool (*is_stopped)()) noexcept;
+    void SetSignals(SearchSignals* signals) noexcept;
 
     SearchResult Search(Position& root, const SearchLimits& limits);
 
+    // Root moves of the last search, best first, with the node distribution of its last iteration
+    const std::vector<RootMove>& GetRootMoves() const noexcept;
+
 private:
     // Core search routines
-    int AlphaBeta(Position& pos, int depth, int alpha, int beta, int halfmove, PvLine& pv);
-    int Quiescence(Position& pos, int alpha, int beta, int halfmove, PvLine& pv);
+    int AlphaBeta(Position& pos, int depth, int alpha, int beta, int halfmove);
+    // depth counts quiescence plies from the horizon: quiet checks are searched only at depth 0
+    int Quiescence(Position& pos, int alpha, int beta, int halfmove, int depth = 0);
+    // Root search of one iteration (or one MultiPV pass) inside an aspiration window around prev_score
+    int AspirationSearch(Position& root, int depth, int prev_score, IterationStats& iteration, bool& stopped);
+
+    // Search stack helpers
+    void UpdatePv(int halfmove, const Move& move) noexcept;
+    static void PickNextMove(SearchStackEntry& entry, int from_index, int count) noexcept;
 
     // Time / stop helpers
     bool IsTimeUp() const noexcept;
+    // Reads the signals and the clock; called every kPollInterval nodes and between iterations
+    void PollSignals() noexcept;
 
     // Mate-score normalization for transposition table
     static bool IsMateScore(int score) noexcept;
@@ -89,6 +202,33 @@ private:
 
     void ResetCutoffKeys() noexcept;
 
+    // Adds the TT counts gathered since the last call to the table totals (once per iteration)
+    void FlushTTCounters() noexcept;
+
+    // MultiPV: root moves already reported in this iteration are skipped by later passes
+    bool IsRootExcluded(const Move& m) const noexcept;
+
+    // Root move list: built once per search, re-sorted after every root search
+    void InitRootMoves(const Position& root);
+    RootMove* FindRootMove(const Move& m) noexcept;
+    void SortRootMoves(int from_index) noexcept;
+    // From the second iteration on the root is searched in root list order
+    void OrderRootMoves(SearchStackEntry& entry) const noexcept;
+    double BestMoveNodeShare() const noexcept;
+
+    // Base late move reduction from the precomputed [depth][move_index] table
+    static int LmrReduction(int depth, int move_index) noexcept;
+
+    // Ordering context with cutoff moves, countermove and continuation rows of this halfmove
+    MoveOrdering::Context MakeOrderingContext(int halfmove, Side stm, const Move& tt_move) const noexcept;
+
+    // Rewards the cutoff move and penalises the moves searched before it
+    void UpdateHistories(int halfmove, Side stm, const Move& best, bool best_is_simple, int depth) noexcept;
+
+    inline static bool SameMove(const Move& a, const Move& b) {
+        return a.GetFrom() == b.GetFrom() && a.GetTo() == b.GetTo() && a.GetFlag() == b.GetFlag();
+    }
+
     // Compact 16-bit key: from | (to << 8)
     inline static uint16_t FromToKey(const Move& m) {
         return static_cast<uint16_t>(m.GetFrom() | (m.GetTo() << 8));
@@ -97,10 +237,20 @@ private:
     inline bool IncreaseNodeCounter() noexcept {
         // First check external stop callback
         if (is_stopped_ && is_stopped_()) {
+            aborted_ = true;
             return false;
         }
-        // Pre-check node limit to avoid crossing it
-        if (limits_.nodes_limit > 0 && nodes_ >= limits_.nodes_limit) {
+        // Signals and clock are read only every kPollInterval nodes
+        if ((nodes_ & (kPollInterval - 1)) == 0) {
+            PollSignals();
+        }
+        if (aborted_) {
+            return false;
+        }
+        // Pre-check node limit to avoid crossing it; the cut-off iteration is discarded like a
+        // timed-out one, and as with the clock the first iteration always completes
+        if (limits_.nodes_limit > 0 && nodes_ >= limits_.nodes_limit && root_depth_ > 1) {
+            aborted_ = true;
             return false;
         }
         ++nodes_;
@@ -108,14 +258,30 @@ private:
     }
 
 private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int64_t kPollInterval = 1024;
+
     TranspositionTable& tt_;
     bool (*is_stopped_)() = nullptr;
 
+    SearchSignals* signals_ = nullptr;
+    bool aborted_ = false;          // stop signal or time limit seen; the iteration is discarded
+    bool pondering_ = false;        // ponder search still waiting for the ponderhit
+    bool has_deadline_ = false;
+    Clock::time_point deadline_{};
+
     int64_t nodes_ = 0;
+    SearchStats stats_{};
+    TranspositionTable::Counters tt_counters_{}; // not yet added to tt_'s totals
+    std::vector<SearchStackEntry> stack_; // kMaxSearchPly + 1 entries, allocated once
     uint16_t cutoff_keys_[256][2]{}; // Two cutoff moves per halfmove (0 = empty)
-    int history_[2][64][64]{};       // Simple move history (side, from, to)
+    std::unique_ptr<SearchHistory> history_; // Ordering statistics, one contiguous block per engine
+
+    int root_depth_ = 0;             // Depth of the current iteration (bounds check extensions)
 
-    int lmr_base_index_ = 4;         // Start LMR from the 4th simple move
+    Move root_excluded_[kMaxMultiPv]; // Root moves of the lines found so far in this iteration
+    int root_excluded_count_ = 0;
+    std::vector<RootMove> root_moves_; // Capacity of MoveList::kMaxMoves reserved once
 
     SearchLimits limits_{};
 
@@ -0,0 +1,108 @@
+#include "search_history.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+void SearchHistory::Clear() {
+    std::memset(butterfly_, 0, sizeof(butterfly_));
+    std::memset(countermove_, 0, sizeof(countermove_));
+    std::memset(continuation_, 0, sizeof(continuation_));
+    std::memset(capture_, 0, sizeof(capture_));
+}
+
+int SearchHistory::Bonus(int depth) {
+    return std::min(32 * depth * depth, 1536);
+}
+
+/*──────────────── Butterfly ───────────────*/
+
+int SearchHistory::GetButterfly(Side side, const Move& move) const {
+    return butterfly_[static_cast<int>(side)][move.GetFrom()][move.GetTo()];
+}
+
+void SearchHistory::UpdateButterfly(Side side, const Move& move, int bonus) {
+    Gravity(butterfly_[static_cast<int>(side)][move.GetFrom()][move.GetTo()], bonus);
+}
+
+/*──────────────── Countermoves ────────────*/
+
+uint16_t SearchHistory::GetCountermove(const Move& previous) const {
+    if (!HasPiece(previous)) {
+        return 0;
+    }
+    return countermove_[PieceIndex(previous)][previous.GetTo()];
+}
+
+void SearchHistory::SetCountermove(const Move& previous, const Move& move) {
+    if (!HasPiece(previous)) {
+        return;
+    }
+    countermove_[PieceIndex(previous)][previous.GetTo()] =
+        static_cast<uint16_t>(move.GetFrom() | (move.GetTo() << 8));
+}
+
+/*──────────────── Continuation ────────────*/
+
+const SearchHistory::PieceToHistory* SearchHistory::GetContinuation(const Move& previous) const {
+    if (!HasPiece(previous)) {
+        return nullptr;
+    }
+    return &continuation_[PieceIndex(previous)][previous.GetTo()];
+}
+
+SearchHistory::PieceToHistory* SearchHistory::GetContinuation(const Move& previous) {
+    if (!HasPiece(previous)) {
+        return nullptr;
+    }
+    return &continuation_[PieceIndex(previous)][previous.GetTo()];
+}
+
+int SearchHistory::ContinuationValue(const PieceToHistory* row, const Move& move) {
+    if (row == nullptr) {
+        return 0;
+    }
+    return (*row)[PieceIndex(move)][move.GetTo()];
+}
+
+void SearchHistory::UpdateContinuation(PieceToHistory* row, const Move& move, int bonus) {
+    if (row == nullptr) {
+        return;
+    }
+    Gravity((*row)[PieceIndex(move)][move.GetTo()], bonus);
+}
+
+/*──────────────── Captures ────────────────*/
+
+int SearchHistory::GetCapture(const Move& move) const {
+    return capture_[PieceIndex(move)][move.GetTo()][VictimIndex(move)];
+}
+
+void SearchHistory::UpdateCapture(const Move& move, int bonus) {
+    Gravity(capture_[PieceIndex(move)][move.GetTo()][VictimIndex(move)], bonus);
+}
+
+/*──────────────── Helpers ─────────────────*/
+
+bool SearchHistory::HasPiece(const Move& move) {
+    return move.GetAttackerType() < static_cast<uint8_t>(PieceType::Count) &&
+           move.GetAttackerSide() < 2;
+}
+
+int SearchHistory::PieceIndex(const Move& move) {
+    return move.GetAttackerSide() * static_cast<int>(PieceType::Count) + move.GetAttackerType();
+}
+
+int SearchHistory::VictimIndex(const Move& move) {
+    // En passant may carry no defender type: the victim is always a pawn
+    if (move.GetDefenderType() >= static_cast<uint8_t>(PieceType::Count)) {
+        return static_cast<int>(PieceType::Pawn);
+    }
+    return move.GetDefenderType();
+}
+
+void SearchHistory::Gravity(int16_t& value, int bonus) {
+    bonus = std::clamp(bonus, -kMaxValue, kMaxValue);
+    const int updated = value + bonus - value * std::abs(bonus) / kMaxValue;
+    value = static_cast<int16_t>(updated);
+}
@@ -0,0 +1,59 @@
+/************
+* SearchHistory — move-ordering statistics learnt during search, one instance per search thread.
+* Contains:
+*   - butterfly history [side][from][to] for simple moves
+*   - countermove table [previous piece][previous to] -> from|to key of the refutation
+*   - continuation history [previous piece][previous to][piece][to] (used 1 and 2 halfmoves back)
+*   - capture history [piece][to][victim]
+* Pieces are indexed as side * 6 + type. All tables live in one contiguous block.
+* Updates use gravity: value += bonus - value * |bonus| / kMaxValue, so values stay
+* within [-kMaxValue, kMaxValue] without rescanning the tables.
+************/
+#pragma once
+
+#include <cstdint>
+
+#include "../board_state/move.h"
+#include "../board_state/pieces.h"
+
+class SearchHistory {
+public:
+    static constexpr int kMaxValue = 16384;
+    static constexpr int kPieceIndexCount = 2 * static_cast<int>(PieceType::Count);
+
+    // One row of continuation history: scores of [piece][to] after a fixed previous move
+    using PieceToHistory = int16_t[kPieceIndexCount][64];
+
+    void Clear();
+
+    // History bonus for a cutoff at the given depth (negated as a malus)
+    static int Bonus(int depth);
+
+    int  GetButterfly(Side side, const Move& move) const;
+    void UpdateButterfly(Side side, const Move& move, int bonus);
+
+    // from|to key of the move that refuted 'previous' last time (0 = none)
+    uint16_t GetCountermove(const Move& previous) const;
+    void     SetCountermove(const Move& previous, const Move& move);
+
+    // Continuation row for the move played before; nullptr for a null move or the root
+    const PieceToHistory* GetContinuation(const Move& previous) const;
+    PieceToHistory*       GetContinuation(const Move& previous);
+
+    static int  ContinuationValue(const PieceToHistory* row, const Move& move);
+    static void UpdateContinuation(PieceToHistory* row, const Move& move, int bonus);
+
+    int  GetCapture(const Move& move) const;
+    void UpdateCapture(const Move& move, int bonus);
+
+private:
+    static bool HasPiece(const Move& move);
+    static int  PieceIndex(const Move& move);
+    static int  VictimIndex(const Move& move);
+    static void Gravity(int16_t& value, int bonus);
+
+    int16_t  butterfly_[2][64][64];
+    uint16_t countermove_[kPieceIndexCount][64];
+    PieceToHistory continuation_[kPieceIndexCount][64];
+    int16_t  capture_[kPieceIndexCount][64][static_cast<int>(PieceType::Count)];
+};
@@ -6,7 +6,7 @@
 #include "../move_generation/pawn_attack_masks.h"
 #include "../move_generation/knight_masks.h"
 #include "../move_generation/king_masks.h"
-#include "../move_generation/sliders_masks.h"
+#include "../move_generation/ps_legal_move_mask_gen.h"
 #include "../board_state/bitboard.h"
 
 namespace {
@@ -94,37 +94,6 @@ struct AttackersByType {
     Bitboard kings[2];
 };
 
-// First blocker along a ray from target; 64 if none
-inline uint8_t NearestBlockerInRay(Bitboard ray_mask, const BoardSnapshot& snapshot, bool reverse) {
-    Bitboard blockers = ray_mask & snapshot.occ_all;
-    if (!blockers) {
-        return 64;
-    }
-    if (reverse) {
-        return BOp::BitScanReverse(blockers);
-    } else {
-        return BOp::BitScanForward(blockers);
-    }
-}
-
-// If the piece at sq on side_index is bishop or queen, mark as diagonal attacker
-inline void MaybeTagBishopOrQueen(const BoardSnapshot& snapshot, int side_index, uint8_t sq, AttackersByType& out) {
-    if (BOp::GetBit(snapshot.piece_bb[side_index][PieceType::Bishop], sq)) {
-        out.bishops[side_index] = BOp::Set_1(out.bishops[side_index], sq);
-    } else if (BOp::GetBit(snapshot.piece_bb[side_index][PieceType::Queen], sq)) {
-        out.queens[side_index] = BOp::Set_1(out.queens[side_index], sq);
-    }
-}
-
-// If the piece at sq on side_index is rook or queen, mark as orthogonal attacker
-inline void MaybeTagRookOrQueen(const BoardSnapshot& snapshot, int side_index, uint8_t sq, AttackersByType& out) {
-    if (BOp::GetBit(snapshot.piece_bb[side_index][PieceType::Rook], sq)) {
-        out.rooks[side_index] = BOp::Set_1(out.rooks[side_index], sq);
-    } else if (BOp::GetBit(snapshot.piece_bb[side_index][PieceType::Queen], sq)) {
-        out.queens[side_index] = BOp::Set_1(out.queens[side_index], sq);
-    }
-}
-
 // Forward declaration for LegalKingCaptureFilter
 inline AttackersByType CollectAttackers(const BoardSnapshot& snapshot, uint8_t target_square);
 
@@ -176,65 +145,24 @@ inline void LegalKingCaptureFilter(const BoardSnapshot& snapshot, uint8_t target
     }
 }
 
-// Build attacker sets for the current snapshot at target_square
+// Build attacker sets for the current snapshot at target_square: one lookup per piece class
+// (PsLegalMaskGen attack primitives), queens found on both slider rays
 inline AttackersByType CollectAttackers(const BoardSnapshot& snapshot, uint8_t target_square) {
     AttackersByType attackers{};
-    Bitboard mask_knight = KnightMasks::kMasks[target_square];
-    Bitboard mask_king   = KingMasks::kMasks[target_square];
-
-    attackers.knights[0] = snapshot.piece_bb[0][PieceType::Knight] & mask_knight;
-    attackers.knights[1] = snapshot.piece_bb[1][PieceType::Knight] & mask_knight;
-    attackers.kings[0]   = snapshot.piece_bb[0][PieceType::King]   & mask_king;
-    attackers.kings[1]   = snapshot.piece_bb[1][PieceType::King]   & mask_king;
-
-    attackers.pawns[0] = snapshot.piece_bb[0][PieceType::Pawn] &
-                         PawnMasks::kAttack[static_cast<int>(Side::Black)][target_square];
-    attackers.pawns[1] = snapshot.piece_bb[1][PieceType::Pawn] &
-                         PawnMasks::kAttack[static_cast<int>(Side::White)][target_square];
-
-    using D = SlidersMasks::Direction;
-    uint8_t blocker_square = 64; // first blocker on ray, if any
-
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::NorthWest], snapshot, false);
-    if (blocker_square < 64) {
-        MaybeTagBishopOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagBishopOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::NorthEast], snapshot, false);
-    if (blocker_square < 64) {
-        MaybeTagBishopOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagBishopOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::SouthWest], snapshot, true);
-    if (blocker_square < 64) {
-        MaybeTagBishopOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagBishopOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::SouthEast], snapshot, true);
-    if (blocker_square < 64) {
-        MaybeTagBishopOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagBishopOrQueen(snapshot, 1, blocker_square, attackers);
-    }
+    const Bitboard mask_knight = KnightMasks::kMasks[target_square];
+    const Bitboard mask_king   = KingMasks::kMasks[target_square];
+    const Bitboard diagonal    = PsLegalMaskGen::BishopAttacks(target_square, snapshot.occ_all);
+    const Bitboard straight    = PsLegalMaskGen::RookAttacks(target_square, snapshot.occ_all);
 
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::North], snapshot, false);
-    if (blocker_square < 64) {
-        MaybeTagRookOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagRookOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::South], snapshot, true);
-    if (blocker_square < 64) {
-        MaybeTagRookOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagRookOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::West], snapshot, true);
-    if (blocker_square < 64) {
-        MaybeTagRookOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagRookOrQueen(snapshot, 1, blocker_square, attackers);
-    }
-    blocker_square = NearestBlockerInRay(SlidersMasks::kMasks[target_square][D::East], snapshot, false);
-    if (blocker_square < 64) {
-        MaybeTagRookOrQueen(snapshot, 0, blocker_square, attackers);
-        MaybeTagRookOrQueen(snapshot, 1, blocker_square, attackers);
+    for (int side_index = 0; side_index < 2; ++side_index) {
+        const auto& bb = snapshot.piece_bb[side_index];
+        // A pawn attacks the target from where an enemy pawn on the target would attack
+        attackers.pawns[side_index]   = bb[PieceType::Pawn] & PawnMasks::kAttack[1 - side_index][target_square];
+        attackers.knights[side_index] = bb[PieceType::Knight] & mask_knight;
+        attackers.bishops[side_index] = bb[PieceType::Bishop] & diagonal;
+        attackers.rooks[side_index]   = bb[PieceType::Rook]   & straight;
+        attackers.queens[side_index]  = bb[PieceType::Queen]  & (diagonal | straight);
+        attackers.kings[side_index]   = bb[PieceType::King]   & mask_king;
     }
 
     LegalKingCaptureFilter(snapshot, target_square, attackers);
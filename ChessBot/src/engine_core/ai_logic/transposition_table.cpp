@@ -1,5 +1,206 @@
 #include "transposition_table.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#include "../board_state/zobrist_hash.h"
+
+static constexpr char kFileMagic[8] = {'C', 'B', 'O', 'T', 'T', 'T', '\0', '\0'};
+
+static_assert(sizeof(TranspositionTable::FileHeader) % alignof(TranspositionTable::Entry) == 0,
+              "mapped entries must stay aligned after the header");
+
+// Maps the whole file copy-on-write: pages are read on first touch and writes stay private
+static bool MapFilePrivate(const std::string& path, void*& out_base, std::size_t& out_bytes) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+
+    // The view keeps the mapping object alive
+    void* base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (base == nullptr) {
+        return false;
+    }
+
+    out_base = base;
+    out_bytes = static_cast<std::size_t>(size.QuadPart);
+    return true;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    out_base = base;
+    out_bytes = bytes;
+    return true;
+#endif
+}
+
+static void UnmapFile(void* base, std::size_t bytes) {
+#if defined(_WIN32)
+    (void)bytes;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, bytes);
+#endif
+}
+
+static constexpr std::size_t kLargePageSize = 2ull * 1024ull * 1024ull;
+
+// Table size used when a resize cannot get the requested memory
+static constexpr std::size_t kFallbackBytes = 1ull * 1024ull * 1024ull;
+
+// Entries sampled by HashfullPermille()
+static constexpr uint64_t kHashfullSample = 1000;
+
+// Entries per clearing thread below which extra threads cost more than they save
+static constexpr uint64_t kMinClearChunk = 1ull << 20;
+
+#if defined(__linux__)
+// Interleaves the not yet touched range over the NUMA nodes this process may use
+static void InterleaveOverNumaNodes(void* addr, std::size_t bytes) {
+    constexpr int kMpolInterleave = 3;
+    constexpr unsigned long kMpolFMemsAllowed = 1ul << 2;
+    constexpr unsigned long kMaxNodes = 1024;
+
+    unsigned long nodes[kMaxNodes / (8 * sizeof(unsigned long))]{};
+    if (syscall(SYS_get_mempolicy, nullptr, nodes, kMaxNodes, nullptr, kMpolFMemsAllowed) != 0) {
+        return;
+    }
+
+    // Best effort: the table works the same with the default (first-touch) policy
+    syscall(SYS_mbind, addr, bytes, kMpolInterleave, nodes, kMaxNodes, 0);
+}
+#endif
+
+// Allocates zero-filled memory aligned to kLargePageSize: explicit huge pages first, then
+// transparent huge pages requested with madvise, then normal pages. out_base/out_bytes describe
+// the whole OS allocation, which may start before the aligned block.
+static void* AllocateTable(std::size_t bytes, bool numa_interleave,
+                           void*& out_base, std::size_t& out_bytes, bool& out_large_pages) {
+    bytes = (bytes + kLargePageSize - 1) / kLargePageSize * kLargePageSize;
+    out_large_pages = false;
+
+#if defined(_WIN32)
+    (void)numa_interleave;
+
+    // Large pages need the "Lock pages in memory" privilege; without it the call simply fails
+    const SIZE_T large_min = GetLargePageMinimum();
+    if (large_min > 0 && bytes % large_min == 0) {
+        void* base = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (base != nullptr) {
+            out_base = base;
+            out_bytes = bytes;
+            out_large_pages = true;
+            return base;
+        }
+    }
+
+    void* base = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    out_base = base;
+    out_bytes = bytes;
+    return base;
+#else
+#if defined(MAP_HUGETLB)
+    void* huge = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (huge != MAP_FAILED) {
+#if defined(__linux__)
+        if (numa_interleave) {
+            InterleaveOverNumaNodes(huge, bytes);
+        }
+#endif
+        out_base = huge;
+        out_bytes = bytes;
+        out_large_pages = true;
+        return huge;
+    }
+#endif
+
+    // Over-allocate so that an aligned block fits; transparent huge pages need aligned ranges
+    const std::size_t total = bytes + kLargePageSize;
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const uintptr_t raw = reinterpret_cast<uintptr_t>(base);
+    void* aligned = reinterpret_cast<void*>((raw + kLargePageSize - 1) & ~(uintptr_t{kLargePageSize} - 1));
+
+#if defined(MADV_HUGEPAGE)
+    out_large_pages = madvise(aligned, bytes, MADV_HUGEPAGE) == 0;
+#endif
+#if defined(__linux__)
+    if (numa_interleave) {
+        InterleaveOverNumaNodes(aligned, bytes);
+    }
+#else
+    (void)numa_interleave;
+#endif
+
+    out_base = base;
+    out_bytes = total;
+    return aligned;
+#endif
+}
+
+static void FreeTable(void* base, std::size_t bytes) {
+#if defined(_WIN32)
+    (void)bytes;
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, bytes);
+#endif
+}
+
 static uint64_t NextPowerOfTwo(uint64_t value) {
     if (value == 0) {
         return 1;
@@ -16,7 +217,15 @@ static uint64_t NextPowerOfTwo(uint64_t value) {
     return value + 1;
 }
 
-TranspositionTable::TranspositionTable(std::size_t hash_size_mb) {
+TranspositionTable::TranspositionTable(std::size_t hash_size_mb, bool numa_interleave)
+    : numa_interleave_(numa_interleave) {
+    // Failed allocates nothing, so there is no storage to release before throwing
+    if (Resize(hash_size_mb) == ResizeResult::Failed) {
+        throw std::bad_alloc();
+    }
+}
+
+TranspositionTable::ResizeResult TranspositionTable::Resize(std::size_t hash_size_mb) {
     const uint64_t bytes = static_cast<uint64_t>(hash_size_mb) * 1024ull * 1024ull;
     uint64_t entry_count = bytes / sizeof(Entry);
 
@@ -26,22 +235,270 @@ TranspositionTable::TranspositionTable(std::size_t hash_size_mb) {
 
     entry_count = NextPowerOfTwo(entry_count);
 
-    table_.assign(entry_count, Entry{});
+    // The fallback table is secured while the old one is still in place, so a failure leaves
+    // a valid table behind; it is small enough not to matter for peak memory
+    const uint64_t fallback_count = NextPowerOfTwo(kFallbackBytes / sizeof(Entry));
+    void* fallback_base = nullptr;
+    std::size_t fallback_bytes = 0;
+    bool fallback_large_pages = false;
+    void* fallback = AllocateTable(fallback_count * sizeof(Entry), numa_interleave_,
+                                   fallback_base, fallback_bytes, fallback_large_pages);
+    if (fallback == nullptr) {
+        return ResizeResult::Failed;
+    }
+
+    // The old table goes before the requested one so that peak memory never holds both
+    ReleaseStorage();
+    ResetCounters();
+
+    void* table = nullptr;
+    if (entry_count != fallback_count) {
+        table = AllocateTable(entry_count * sizeof(Entry), numa_interleave_,
+                              storage_base_, storage_bytes_, large_pages_);
+    }
+
+    ResizeResult result = ResizeResult::Resized;
+    if (table != nullptr) {
+        FreeTable(fallback_base, fallback_bytes);
+    }
+    else {
+        result = (entry_count == fallback_count) ? ResizeResult::Resized : ResizeResult::Fallback;
+        entry_count = fallback_count;
+        table = fallback;
+        storage_base_ = fallback_base;
+        storage_bytes_ = fallback_bytes;
+        large_pages_ = fallback_large_pages;
+    }
+
+    storage_ = Storage::Allocated;
+    table_ = static_cast<Entry*>(table);
+    entry_count_ = entry_count;
     index_mask_ = entry_count - 1;
+
+    // First touch happens here, on the clearing threads (and on their NUMA nodes)
+    Clear();
+    return result;
+}
+
+TranspositionTable::~TranspositionTable() {
+    ReleaseStorage();
 }
 
 void TranspositionTable::Clear() {
-    for (auto& entry : table_) {
-        entry = Entry{};
+    const uint64_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t threads = std::max<uint64_t>(1, std::min(hardware, entry_count_ / kMinClearChunk));
+    const uint64_t chunk = entry_count_ / threads;
+
+    auto ClearRange = [this](uint64_t begin, uint64_t end) {
+        std::fill(table_ + begin, table_ + end, Entry{});
+    };
+
+    std::vector<std::thread> workers;
+    for (uint64_t t = 1; t < threads; ++t) {
+        workers.emplace_back(ClearRange, t * chunk, (t + 1 == threads) ? entry_count_ : (t + 1) * chunk);
     }
+
+    ClearRange(0, threads == 1 ? entry_count_ : chunk);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+uint64_t TranspositionTable::GetEntryCount() const noexcept {
+    return entry_count_;
+}
+
+bool TranspositionTable::UsesLargePages() const noexcept {
+    return storage_ == Storage::Allocated && large_pages_;
+}
+
+void TranspositionTable::NewSearch() noexcept {
+    ++generation_;
+}
+
+int TranspositionTable::HashfullPermille() const noexcept {
+    const uint64_t sample = std::min<uint64_t>(kHashfullSample, entry_count_);
+    if (sample == 0) {
+        return 0;
+    }
+
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < sample; ++i) {
+        used += (table_[i].depth >= 0 && table_[i].generation == generation_) ? 1 : 0;
+    }
+    return static_cast<int>(used * 1000 / sample);
+}
+
+TranspositionTable::Counters TranspositionTable::GetCounters() const noexcept {
+    Counters counters{};
+    counters.probes     = probes_.load(std::memory_order_relaxed);
+    counters.hits       = hits_.load(std::memory_order_relaxed);
+    counters.collisions = collisions_.load(std::memory_order_relaxed);
+    counters.stores     = stores_.load(std::memory_order_relaxed);
+    counters.overwrites = overwrites_.load(std::memory_order_relaxed);
+    counters.misses     = counters.probes - counters.hits;
+    return counters;
+}
+
+void TranspositionTable::AddCounters(const Counters& counts) noexcept {
+    probes_.fetch_add(counts.probes, std::memory_order_relaxed);
+    hits_.fetch_add(counts.hits, std::memory_order_relaxed);
+    collisions_.fetch_add(counts.collisions, std::memory_order_relaxed);
+    stores_.fetch_add(counts.stores, std::memory_order_relaxed);
+    overwrites_.fetch_add(counts.overwrites, std::memory_order_relaxed);
+}
+
+void TranspositionTable::ResetCounters() noexcept {
+    probes_.store(0, std::memory_order_relaxed);
+    hits_.store(0, std::memory_order_relaxed);
+    collisions_.store(0, std::memory_order_relaxed);
+    stores_.store(0, std::memory_order_relaxed);
+    overwrites_.store(0, std::memory_order_relaxed);
 }
 
-bool TranspositionTable::Probe(uint64_t key, int depth, int alpha, int beta, int& out_score, Move& out_best_move) const {
+bool TranspositionTable::Save(const std::string& path) const {
+    FileHeader header{};
+    std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kFileVersion;
+    header.entry_size = sizeof(Entry);
+    header.entry_count = entry_count_;
+    header.zobrist_fingerprint = ZobristHash::Fingerprint();
+    header.checksum = Checksum(table_, entry_count_);
+
+    // Written next to the target and renamed over it: a table loaded from path may still be
+    // mapped from the old file, which must never be truncated or rewritten in place
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table_), static_cast<std::streamsize>(entry_count_ * sizeof(Entry)));
+        out.flush();
+        if (!out) {
+            out.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TranspositionTable::Load(const std::string& path, bool verify_entries) {
+    void* base = nullptr;
+    std::size_t bytes = 0;
+    if (!MapFilePrivate(path, base, bytes)) {
+        return false;
+    }
+
+    auto Reject = [base, bytes]() {
+        UnmapFile(base, bytes);
+        return false;
+    };
+
+    if (bytes < sizeof(FileHeader)) {
+        return Reject();
+    }
+
+    FileHeader header{};
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        header.version != kFileVersion || header.entry_size != sizeof(Entry)) {
+        return Reject();
+    }
+
+    // Keys hashed with other Zobrist constants would only produce false hits
+    if (header.zobrist_fingerprint != ZobristHash::Fingerprint()) {
+        return Reject();
+    }
+
+    const uint64_t count = header.entry_count;
+    if (count == 0 || (count & (count - 1)) != 0 || count > (bytes - sizeof(FileHeader)) / sizeof(Entry) ||
+        bytes != sizeof(FileHeader) + count * sizeof(Entry)) {
+        return Reject();
+    }
+
+    Entry* entries = reinterpret_cast<Entry*>(static_cast<char*>(base) + sizeof(FileHeader));
+    if (verify_entries && Checksum(entries, count) != header.checksum) {
+        return Reject();
+    }
+
+    // Adopt the mapping; the previous storage is released
+    ReleaseStorage();
+
+    storage_ = Storage::Mapped;
+    storage_base_ = base;
+    storage_bytes_ = bytes;
+    large_pages_ = false;
+    table_ = entries;
+    entry_count_ = count;
+    index_mask_ = count - 1;
+    ResetCounters();
+    return true;
+}
+
+// Word-wise multiply-xorshift hash over the raw entry bytes
+uint64_t TranspositionTable::Checksum(const Entry* entries, uint64_t count) noexcept {
+    static_assert(sizeof(Entry) % sizeof(uint64_t) == 0, "entries are hashed as whole 64-bit words");
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(entries);
+    const uint64_t words = count * (sizeof(Entry) / sizeof(uint64_t));
+
+    uint64_t hash = 0xCBF29CE484222325ull ^ count;
+    for (uint64_t i = 0; i < words; ++i) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(word));
+
+        hash ^= word;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+void TranspositionTable::ReleaseStorage() noexcept {
+    if (storage_ == Storage::Allocated) {
+        FreeTable(storage_base_, storage_bytes_);
+    }
+    else if (storage_ == Storage::Mapped) {
+        UnmapFile(storage_base_, storage_bytes_);
+    }
+
+    storage_ = Storage::None;
+    storage_base_ = nullptr;
+    storage_bytes_ = 0;
+    table_ = nullptr;
+    entry_count_ = 0;
+    index_mask_ = 0;
+}
+
+bool TranspositionTable::Probe(uint64_t key, int depth, int alpha, int beta, int& out_score, Move& out_best_move,
+                               Counters* counters) const {
     const Entry& entry = table_[key & index_mask_];
 
+    if (counters) {
+        ++counters->probes;
+    }
     if (entry.key != key) {
+        if (counters && entry.depth >= 0) {
+            ++counters->collisions;
+        }
         return false;
     }
+    if (counters) {
+        ++counters->hits;
+    }
 
     out_best_move = EntryToMove(entry);
 
@@ -62,8 +519,29 @@ bool TranspositionTable::Probe(uint64_t key, int depth, int alpha, int beta, int
     return false;
 }
 
-void TranspositionTable::Store(uint64_t key, int depth, int score, Bound bound, const Move& best_move) {
-    table_[key & index_mask_] = MoveToEntry(key, depth, score, bound, best_move);
+bool TranspositionTable::Lookup(uint64_t key, Entry& out_entry) const {
+    const Entry& entry = table_[key & index_mask_];
+
+    if (entry.key != key) {
+        return false;
+    }
+
+    out_entry = entry;
+    return true;
+}
+
+void TranspositionTable::Store(uint64_t key, int depth, int score, Bound bound, const Move& best_move,
+                               Counters* counters) {
+    Entry& entry = table_[key & index_mask_];
+
+    if (counters) {
+        ++counters->stores;
+        if (entry.depth >= 0 && entry.key != key) {
+            ++counters->overwrites;
+        }
+    }
+    entry = MoveToEntry(key, depth, score, bound, best_move);
+    entry.generation = generation_;
 }
 
 Move TranspositionTable::EntryToMove(const Entry& entry) {
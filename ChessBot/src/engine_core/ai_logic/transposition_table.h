@@ -1,11 +1,24 @@
 /************
 * TranspositionTable — fixed-size hash table over Zobrist keys.
 * Stores depth, score, bound type, and best move for move ordering.
+* The table can be saved to a versioned binary snapshot and loaded back through a private
+* memory mapping of the file, so a large table is usable without reading it into a copy.
+* Table memory is 2 MB aligned and backed by huge pages where the OS allows it (explicit huge
+* pages, then transparent huge pages, then normal pages), optionally interleaved across NUMA
+* nodes; Clear() zeroes it on several threads. The table can be resized at runtime and reports
+* the fill rate of the current search generation and probe/store counters. Prefetch() lets the
+* search pull a child's slot into the cache while it is still making the move.
 ************/
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 #include "../board_state/move.h"
 
@@ -23,21 +36,129 @@ public:
         uint8_t  best_flag = 0;
         int8_t   depth = -1;              // halfmove
         Bound    bound = Bound::Exact;
+        uint8_t  generation = 0;          // NewSearch() count of the storing search (wraps at 256)
+    };
+
+    // Snapshot file layout: this header followed by entry_count raw entries
+    struct FileHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t entry_size;          // sizeof(Entry) of the writer
+        uint64_t entry_count;         // power of two
+        uint64_t zobrist_fingerprint; // ZobristHash::Fingerprint() of the writer
+        uint64_t checksum;            // Checksum() of the entries
+    };
+
+    static constexpr uint32_t kFileVersion = 2;
+
+    // Table totals count since construction, the last Resize(), Load() or ResetCounters().
+    // Probe/Store count into a caller-owned Counters (plain increments on the searcher's memory),
+    // which the search folds into the shared totals with AddCounters() once per iteration.
+    struct Counters {
+        uint64_t probes = 0;
+        uint64_t hits = 0;       // probes that found their key
+        uint64_t misses = 0;     // probes - hits
+        uint64_t collisions = 0; // misses on a slot used by another key
+        uint64_t stores = 0;
+        uint64_t overwrites = 0; // stores replacing another key's entry
     };
 
-    explicit TranspositionTable(std::size_t hash_size_mb = 64);
+    // numa_interleave spreads the pages over all allowed NUMA nodes (Linux; ignored elsewhere)
+    explicit TranspositionTable(std::size_t hash_size_mb = 64, bool numa_interleave = false);
+    ~TranspositionTable();
 
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Resets every entry, splitting the table over up to hardware_concurrency() threads
     void Clear();
 
+    enum class ResizeResult : uint8_t {
+        Resized,  // table of the requested size
+        Fallback, // requested size unavailable: a 1 MB table is used instead
+        Failed    // not even the fallback could be allocated: the previous table is kept
+    };
+
+    // Replaces the table with an empty one of the new size (rounded up to a power of two entries).
+    // The old memory is released before the new table is allocated; only the 1 MB fallback is
+    // secured first, so the table stays valid whatever the outcome. Must not run concurrently
+    // with a search. The constructor throws std::bad_alloc only on Failed.
+    ResizeResult Resize(std::size_t hash_size_mb);
+
+    // Starts a new generation: entries stored from now on count as the current search's
+    void NewSearch() noexcept;
+
+    // Entries of the current generation per mille among the first 1000 slots; the table is not
+    // cleared between moves, so older entries would otherwise keep it at ~1000 for the whole game
+    int HashfullPermille() const noexcept;
+
+    Counters GetCounters() const noexcept;
+    void ResetCounters() noexcept;
+    void AddCounters(const Counters& counts) noexcept; // misses are derived, not added
+
     // Returns true if entry is usable for the (depth, alpha, beta) window.
-    bool Probe(uint64_t key, int depth, int alpha, int beta, int& out_score, Move& out_best_move) const;
+    // counters (optional) receives the probe's hit/collision classification
+    bool Probe(uint64_t key, int depth, int alpha, int beta, int& out_score, Move& out_best_move,
+               Counters* counters = nullptr) const;
+
+    // Copies the entry stored for key without any depth/window test (false if the key does not match).
+    // Used where the caller needs the raw depth and bound, e.g. singular extension checks.
+    bool Lookup(uint64_t key, Entry& out_entry) const;
+
+    void Store(uint64_t key, int depth, int score, Bound bound, const Move& best_move,
+               Counters* counters = nullptr);
+
+    // Starts loading the slot of key into the cache ahead of its Probe/Store
+    void Prefetch(uint64_t key) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&table_[key & index_mask_]);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(reinterpret_cast<const char*>(&table_[key & index_mask_]), _MM_HINT_T0);
+#else
+        (void)key;
+#endif
+    }
+
+    uint64_t GetEntryCount() const noexcept;
+
+    // True when the allocated table is backed by explicit or transparent huge pages (as requested)
+    bool UsesLargePages() const noexcept;
 
-    void Store(uint64_t key, int depth, int score, Bound bound, const Move& best_move);
+    // Writes the whole table to a temporary file and renames it over path; false on any I/O error.
+    // The file a loaded table is mapped from is thus never modified, even when saving to it.
+    bool Save(const std::string& path) const;
+
+    // Replaces the table with the snapshot at path (size included), mapped copy-on-write so stores
+    // never reach the file. Returns false and keeps the current table when the file is missing,
+    // truncated, of another version or entry layout, or hashed with other Zobrist keys. Only the
+    // header is read, so entry pages are faulted in as the search touches them; verify_entries
+    // also checks the entry checksum, which reads the whole file up front.
+    bool Load(const std::string& path, bool verify_entries = false);
+
+    static uint64_t Checksum(const Entry* entries, uint64_t count) noexcept;
 
 private:
-    std::vector<Entry> table_;
+    enum class Storage : uint8_t { None, Allocated, Mapped };
+
+    Entry* table_ = nullptr;   // allocated block or the entries of the mapped snapshot
+    uint64_t entry_count_ = 0;
     uint64_t index_mask_ = 0;
 
+    Storage storage_ = Storage::None;
+    void* storage_base_ = nullptr; // start of the OS allocation or of the snapshot mapping
+    std::size_t storage_bytes_ = 0;
+    bool large_pages_ = false;
+    bool numa_interleave_ = false;
+    uint8_t generation_ = 0;
+
+    std::atomic<uint64_t> probes_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> collisions_{0};
+    std::atomic<uint64_t> stores_{0};
+    std::atomic<uint64_t> overwrites_{0};
+
+    void ReleaseStorage() noexcept;
+
     static Move EntryToMove(const Entry& entry);
     static Entry MoveToEntry(uint64_t key, int depth, int score, Bound bound, const Move& move);
 };
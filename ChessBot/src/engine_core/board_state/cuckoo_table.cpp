@@ -0,0 +1,16 @@
+#include "cuckoo_table.h"
+
+const CuckooTable::Entry* CuckooTable::Find(uint64_t move_key) {
+    const auto& entries = CuckooMoves::kTable.entries;
+
+    const Entry* entry = &entries[CuckooMoves::H1(move_key)];
+    if (entry->key == move_key && entry->from != entry->to) {
+        return entry;
+    }
+
+    entry = &entries[CuckooMoves::H2(move_key)];
+    if (entry->key == move_key && entry->from != entry->to) {
+        return entry;
+    }
+    return nullptr;
+}
@@ -0,0 +1,124 @@
+/************************************************
+* CuckooTable — precomputed Zobrist deltas of all reversible moves.
+*
+* Every non-pawn piece move between two squares on an empty board is
+* stored by the key difference it produces (both squares + side to move).
+* Used by Position::HasUpcomingRepetition() to see whether the side to move
+* can return to an earlier position in one move ("has_game_cycle").
+*
+* Contains:
+* - Two-hash cuckoo table (8192 entries) of key deltas and squares, built at
+*   compile time from ZobristKeys::kKeys (no startup initialization)
+* - Lookup by key delta
+************************************************/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+#include "zobrist_hash.h"
+#include "pieces.h"
+#include "../move_generation/knight_masks.h"
+#include "../move_generation/king_masks.h"
+#include "../move_generation/sliders_masks.h"
+
+namespace CuckooMoves {
+
+struct Entry {
+    uint64_t key = 0;
+    uint8_t  from = 0;
+    uint8_t  to = 0;     // from == to marks an empty slot
+};
+
+constexpr uint32_t kSize = 8192;
+
+constexpr uint32_t H1(uint64_t key) { return static_cast<uint32_t>(key & (kSize - 1)); }
+constexpr uint32_t H2(uint64_t key) { return static_cast<uint32_t>((key >> 16) & (kSize - 1)); }
+
+struct Table {
+    std::array<Entry, kSize> entries{};
+    uint32_t entry_count = 0;
+};
+
+// Squares reachable from 'sq' on an empty board
+constexpr Bitboard EmptyBoardAttacks(PieceType type, uint8_t sq) {
+    using D = SlidersMasks::Direction;
+    const auto& rays = SlidersMasks::kMasks[sq];
+
+    const Bitboard diagonal = rays[D::NorthWest] | rays[D::NorthEast] | rays[D::SouthWest] | rays[D::SouthEast];
+    const Bitboard straight = rays[D::North] | rays[D::South] | rays[D::West] | rays[D::East];
+
+    switch (type) {
+    case PieceType::Knight:
+        return KnightMasks::kMasks[sq];
+    case PieceType::Bishop:
+        return diagonal;
+    case PieceType::Rook:
+        return straight;
+    case PieceType::Queen:
+        return diagonal | straight;
+    case PieceType::King:
+        return KingMasks::kMasks[sq];
+    default:
+        return 0;
+    }
+}
+
+// Inserts every move once, from the lower to the higher square; only the set target bits are
+// visited to keep the constant evaluation short
+constexpr Table Generate(const ZobristKeys::KeySet& keys) {
+    Table table;
+
+    for (uint8_t side = 0; side < 2; ++side) {
+        for (PieceType type : { PieceType::Knight, PieceType::Bishop, PieceType::Rook,
+                               PieceType::Queen, PieceType::King }) {
+            for (uint8_t s1 = 0; s1 < 64; ++s1) {
+                Bitboard targets = EmptyBoardAttacks(type, s1) & ~((Bitboard{2} << s1) - 1);
+
+                while (targets) {
+                    const uint8_t s2 = static_cast<uint8_t>(std::countr_zero(targets));
+                    targets &= targets - 1;
+
+                    Entry entry;
+                    entry.key  = keys.pieces[s1][side][type] ^ keys.pieces[s2][side][type] ^ keys.black_to_move;
+                    entry.from = s1;
+                    entry.to   = s2;
+
+                    // Cuckoo insertion: kick the occupant to its alternative slot until a hole is found
+                    uint32_t slot = H1(entry.key);
+                    while (true) {
+                        std::swap(table.entries[slot], entry);
+                        if (entry.from == entry.to) {
+                            break;
+                        }
+                        slot = (slot == H1(entry.key)) ? H2(entry.key) : H1(entry.key);
+                    }
+                    ++table.entry_count;
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+inline constexpr Table kTable = Generate(ZobristKeys::kKeys);
+
+} // namespace CuckooMoves
+
+class CuckooTable {
+public:
+    using Entry = CuckooMoves::Entry;
+
+    static constexpr uint32_t kSize = CuckooMoves::kSize;
+
+    // Returns the stored move for the key delta or nullptr if it is not a reversible move.
+    static const Entry* Find(uint64_t move_key);
+
+    static constexpr uint32_t GetEntryCount() {
+        return CuckooMoves::kTable.entry_count;
+    }
+};
@@ -1,8 +1,28 @@
 #include "position.h"
+#include "cuckoo_table.h"
 #include "../move_generation/pawn_attack_masks.h"
+#include "../move_generation/sliders_masks.h"
 
 #include <iostream>
 #include <cmath>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Position>, "Position is copied between threads by memcpy");
+
+namespace {
+
+// Squares strictly between two squares on a common line (0 if not aligned or adjacent)
+Bitboard BetweenSquares(uint8_t s1, uint8_t s2) {
+    for (uint8_t dir = 0; dir < SlidersMasks::Direction::Count; ++dir) {
+        const Bitboard ray = SlidersMasks::kMasks[s1][dir];
+        if (BOp::GetBit(ray, s2)) {
+            return BOp::Set_0(ray & ~SlidersMasks::kMasks[s2][dir], s2);
+        }
+    }
+    return 0;
+}
+
+} // namespace
 
 // Constructs position from short FEN and flags
 Position::Position(const std::string& short_fen, uint8_t en_passant,
@@ -44,13 +64,12 @@ void Position::ApplyMove(Move move, Undo& u) {
         return;
     }
 
+    repetition_history_.AddPosition(hash_.GetValue());
+
     // Remove the previous move's EP bit from the hash if it was capturable for the side to move.
     if (en_passant_ != NONE) {
         const Side stm = IsWhiteToMove() ? Side::White : Side::Black;
-        const Bitboard pawns_stm = pieces_.GetPieceBitboard(stm, PieceType::Pawn);
-        const Bitboard att_stm   = PawnMasks::kAttack[static_cast<int>(stm)][en_passant_];
-
-        if ((pawns_stm & att_stm) != 0ULL) {
+        if (IsEnPassantCapturable(stm)) {
             hash_.InvertEnPassantFile(en_passant_ % 8);
         }
     }
@@ -76,10 +95,7 @@ void Position::ApplyMove(Move move, Undo& u) {
 
         // Add EP bit to the hash only if the next side has a pawn that can capture it.
         const Side next = IsWhiteToMove() ? Side::Black : Side::White;
-        const Bitboard pawns_next = pieces_.GetPieceBitboard(next, PieceType::Pawn);
-        const Bitboard att_next   = PawnMasks::kAttack[static_cast<int>(next)][en_passant_];
-
-        if ((pawns_next & att_next) != 0ULL) {
+        if (IsEnPassantCapturable(next)) {
             hash_.InvertEnPassantFile(en_passant_ % 8);
         }
         break;
@@ -224,20 +240,109 @@ void Position::ApplyMove(Move move) {
     Undo tmp;
     ApplyMove(move, tmp);
 
+    // Earlier positions can never repeat after an irreversible move
     if (move.GetAttackerType() == 0 || move.GetDefenderType() != Move::None) {
         repetition_history_.Clear();
     }
+}
+
+uint64_t Position::KeyAfter(Move move) const {
+    ZobristHash hash = hash_;
+    const uint8_t side = move.GetAttackerSide();
+    const uint8_t pawn = static_cast<uint8_t>(PieceType::Pawn);
+    const uint8_t rook = static_cast<uint8_t>(PieceType::Rook);
+
+    if (en_passant_ != NONE && IsEnPassantCapturable(IsWhiteToMove() ? Side::White : Side::Black)) {
+        hash.InvertEnPassantFile(en_passant_ % 8);
+    }
+
+    hash.InvertPiece(move.GetFrom(), move.GetAttackerType(), side);
+    hash.InvertPiece(move.GetTo(), move.GetAttackerType(), side);
 
-    repetition_history_.AddPosition(hash_);
+    if (move.GetDefenderType() != Move::None) {
+        hash.InvertPiece(move.GetTo(), move.GetDefenderType(), move.GetDefenderSide());
+    }
+
+    auto PromoteTo = [&](PieceType type) {
+        hash.InvertPiece(move.GetTo(), pawn, side);
+        hash.InvertPiece(move.GetTo(), static_cast<uint8_t>(type), side);
+    };
+
+    switch (move.GetFlag()) {
+    case Move::Flag::PawnLongMove: {
+        // The next side's pawns are not touched by the push, so the current board answers
+        const uint8_t square = static_cast<uint8_t>((move.GetFrom() + move.GetTo()) / 2);
+        const Side next = IsWhiteToMove() ? Side::Black : Side::White;
+        const Bitboard capturers = PawnMasks::kAttack[static_cast<int>(Pieces::Inverse(next))][square];
+        if (pieces_.GetPieceBitboard(next, PieceType::Pawn) & capturers) {
+            hash.InvertEnPassantFile(square % 8);
+        }
+        break;
+    }
+    case Move::Flag::EnPassantCapture:
+        hash.InvertPiece(static_cast<uint8_t>(move.GetTo() + (side == static_cast<uint8_t>(Side::White) ? -8 : 8)),
+                         pawn, static_cast<uint8_t>(Pieces::Inverse(static_cast<Side>(side))));
+        break;
+    case Move::Flag::WhiteShortCastling:
+        hash.InvertPiece(7, rook, side);
+        hash.InvertPiece(5, rook, side);
+        break;
+    case Move::Flag::WhiteLongCastling:
+        hash.InvertPiece(0, rook, side);
+        hash.InvertPiece(3, rook, side);
+        break;
+    case Move::Flag::BlackShortCastling:
+        hash.InvertPiece(63, rook, side);
+        hash.InvertPiece(61, rook, side);
+        break;
+    case Move::Flag::BlackLongCastling:
+        hash.InvertPiece(56, rook, side);
+        hash.InvertPiece(59, rook, side);
+        break;
+    case Move::Flag::PromoteToKnight:
+        PromoteTo(PieceType::Knight);
+        break;
+    case Move::Flag::PromoteToBishop:
+        PromoteTo(PieceType::Bishop);
+        break;
+    case Move::Flag::PromoteToRook:
+        PromoteTo(PieceType::Rook);
+        break;
+    case Move::Flag::PromoteToQueen:
+        PromoteTo(PieceType::Queen);
+        break;
+    default:
+        break;
+    }
+
+    // Castling rights lost by moving from or capturing on a king or rook home square
+    auto LosesRight = [&](uint8_t home_square, uint8_t king_square) {
+        return move.GetFrom() == home_square || move.GetFrom() == king_square ||
+               (move.GetTo() == home_square && move.GetDefenderType() == rook);
+    };
+    if (white_long_castling_ && LosesRight(0, 4)) {
+        hash.InvertWhiteLongCastling();
+    }
+    if (white_short_castling_ && LosesRight(7, 4)) {
+        hash.InvertWhiteShortCastling();
+    }
+    if (black_long_castling_ && LosesRight(56, 60)) {
+        hash.InvertBlackLongCastling();
+    }
+    if (black_short_castling_ && LosesRight(63, 60)) {
+        hash.InvertBlackShortCastling();
+    }
+
+    hash.InvertMove();
+    return hash.GetValue();
 }
 
 void Position::UndoMove(Move move, const Undo& u) {
+    repetition_history_.RemoveLast();
+
     if (en_passant_ != NONE) {
         const Side stm = IsWhiteToMove() ? Side::White : Side::Black;
-        const Bitboard pawns_stm = pieces_.GetPieceBitboard(stm, PieceType::Pawn);
-        const Bitboard att_stm   = PawnMasks::kAttack[static_cast<int>(stm)][en_passant_];
-
-        if ((pawns_stm & att_stm) != 0ULL) {
+        if (IsEnPassantCapturable(stm)) {
             hash_.InvertEnPassantFile(en_passant_ % 8);
         }
 
@@ -304,11 +409,9 @@ void Position::UndoMove(Move move, const Undo& u) {
 
     en_passant_ = u.EnPassantBefore;
     if (en_passant_ != NONE) {
-        const Side stm_prev = IsWhiteToMove() ? Side::White : Side::Black;
-        const Bitboard pawns_prev = pieces_.GetPieceBitboard(stm_prev, PieceType::Pawn);
-        const Bitboard att_prev   = PawnMasks::kAttack[static_cast<int>(stm_prev)][en_passant_];
-
-        if ((pawns_prev & att_prev) != 0ULL) {
+        // move_counter_ is not restored yet, so the side that was to move is the inverse one.
+        const Side stm_prev = IsWhiteToMove() ? Side::Black : Side::White;
+        if (IsEnPassantCapturable(stm_prev)) {
             hash_.InvertEnPassantFile(en_passant_ % 8);
         }
     }
@@ -343,6 +446,10 @@ void Position::UndoMove(Move move, const Undo& u) {
 void Position::ApplyNullMove(NullUndo& u) {
     u.EnPassantBefore   = en_passant_;
     u.MoveCounterBefore = move_counter_;
+    u.FiftyBefore       = fifty_move_counter_;
+
+    // Positions before a null move are unreachable, so the repetition window restarts here.
+    fifty_move_counter_ = 0;
 
     if (en_passant_ != NONE) {
         hash_.InvertEnPassantFile(en_passant_ % 8);
@@ -356,6 +463,7 @@ void Position::ApplyNullMove(NullUndo& u) {
 void Position::UndoNullMove(const NullUndo& u) {
     hash_.InvertMove();
     move_counter_ = u.MoveCounterBefore;
+    fifty_move_counter_ = u.FiftyBefore;
     SetEnPassantSquare(u.EnPassantBefore);
 }
 
@@ -414,6 +522,14 @@ void Position::DisableCastling(Side side, bool long_castle) {
     }
 }
 
+// A pawn of 'side' can capture en passant if it stands on a square attacked from the EP square
+// by a pawn of the opposite colour.
+bool Position::IsEnPassantCapturable(Side side) const {
+    const Bitboard pawns = pieces_.GetPieceBitboard(side, PieceType::Pawn);
+    const Bitboard from  = PawnMasks::kAttack[static_cast<int>(Pieces::Inverse(side))][en_passant_];
+    return (pawns & from) != 0ULL;
+}
+
 void Position::UpdateMoveCounter() {
     ++move_counter_;
 }
@@ -426,8 +542,59 @@ bool Position::IsFiftyMoveRuleDraw() const {
     return fifty_move_counter_ >= 100;
 }
 
+// Two earlier occurrences plus the current position
 bool Position::IsThreefoldRepetition() const {
-    return repetition_history_.GetRepetitionNumber(hash_) >= 3;
+    return repetition_history_.GetRepetitionNumber(hash_.GetValue(), fifty_move_counter_) >= 2;
+}
+
+// Only the reversible plies (bounded by the fifty-move counter) can hold the same position
+bool Position::IsRepetition(uint32_t plies_from_root) const {
+    return repetition_history_.HasRepetition(hash_.GetValue(), fifty_move_counter_, plies_from_root);
+}
+
+// Cuckoo "has_game_cycle": the key difference to a position an odd number of plies back
+// must be a single reversible move of the side to move with a free path. A position from
+// before the search root only counts if it already occurred once more before it.
+bool Position::HasUpcomingRepetition(uint32_t plies_from_root) const {
+    uint32_t window = fifty_move_counter_;
+    if (window > repetition_history_.GetSize()) {
+        window = repetition_history_.GetSize();
+    }
+
+    if (window < 3) {
+        return false;
+    }
+
+    const uint64_t key = hash_.GetValue();
+    const Bitboard own = pieces_.GetSideBoard(IsWhiteToMove() ? Side::White : Side::Black);
+
+    for (uint32_t back = 3; back <= window; back += 2) {
+        const uint64_t move_key = key ^ repetition_history_.GetKey(back);
+        const CuckooTable::Entry* entry = CuckooTable::Find(move_key);
+        if (entry == nullptr) {
+            continue;
+        }
+
+        if (BetweenSquares(entry->from, entry->to) & pieces_.GetAllBitboard()) {
+            continue;
+        }
+
+        if (!BOp::GetBit(own, entry->from) && !BOp::GetBit(own, entry->to)) {
+            continue;
+        }
+
+        if (back <= plies_from_root) {
+            return true;
+        }
+
+        const uint64_t target = repetition_history_.GetKey(back);
+        for (uint32_t earlier = back + 4; earlier <= window; earlier += 2) {
+            if (repetition_history_.GetKey(earlier) == target) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 bool Position::IsWhiteToMove() const {
@@ -8,6 +8,11 @@
 * - Pieces and ZobristHash
 * - Castling flags, en passant square
 * - Side to move, 50-move rule counter, repetition tracker
+* - Repetition history of previous keys (pushed/popped in make/unmake), used for
+*   threefold/search repetitions and cuckoo-based upcoming repetition detection
+* - Key after a move without making it (e.g. to prefetch the child's TT slot)
+*
+* Position holds no heap memory and is trivially copyable (cheap thread handoff).
 ************************************************/
 
 #pragma once
@@ -40,6 +45,10 @@ public:
     bool IsWhiteToMove() const;
     bool IsFiftyMoveRuleDraw() const;
     bool IsThreefoldRepetition() const;
+    // Search draws by repetition; plies_from_root is the distance to the search root, before
+    // which a position must have occurred twice (see RepetitionHistory::HasRepetition)
+    bool IsRepetition(uint32_t plies_from_root) const;
+    bool HasUpcomingRepetition(uint32_t plies_from_root) const; // side to move can repeat with one move
 
     friend std::ostream& operator<<(std::ostream& os, const Position& position);
 
@@ -68,9 +77,14 @@ public:
     void UndoMove(Move move, const Undo& u);
     uint64_t GetZobristKey() const { return hash_.GetValue(); } // for transposition table
 
+    // Key the position would have after ApplyMove(move), computed from the hash deltas only
+    // (pieces, capture, castling rook and rights, en passant, side to move); move must be legal here
+    uint64_t KeyAfter(Move move) const;
+
     struct NullUndo {
         uint8_t  EnPassantBefore = NONE;
         uint16_t MoveCounterBefore = 0;
+        uint8_t  FiftyBefore = 0;
     };
 
     void ApplyNullMove(NullUndo& u);
@@ -83,6 +97,7 @@ private:
     void RemovePiece(uint8_t square, uint8_t type, uint8_t side);
     void SetEnPassantSquare(uint8_t square);
     void DisableCastling(Side side, bool long_castle);
+    bool IsEnPassantCapturable(Side side) const;
 
     void UpdateMoveCounter();
     void UpdateFiftyMovesCounter(bool breaking_event);
@@ -1,19 +1,65 @@
 #include "repetition_history.h"
 
-void RepetitionHistory::AddPosition(ZobristHash hash) {
-    hashes_.push_back(hash);
+void RepetitionHistory::AddPosition(uint64_t key) {
+    keys_[size_ & kMask] = key;
+    ++size_;
+}
+
+void RepetitionHistory::RemoveLast() {
+    if (size_ > 0) {
+        --size_;
+    }
 }
 
 void RepetitionHistory::Clear() {
-    hashes_.clear();
+    size_ = 0;
+}
+
+uint32_t RepetitionHistory::Window(uint32_t window) const {
+    if (window > size_) {
+        window = size_;
+    }
+
+    if (window > kMask) {
+        window = kMask;
+    }
+    return window;
 }
 
-uint8_t RepetitionHistory::GetRepetitionNumber(ZobristHash hash) const {
+uint8_t RepetitionHistory::GetRepetitionNumber(uint64_t key, uint32_t window) const {
+    const uint32_t limit = Window(window);
+
     uint8_t count = 0;
-    for (const auto& past_hash : hashes_) {
-        if (hash == past_hash) {
+    for (uint32_t back = 2; back <= limit; back += 2) {
+        if (keys_[(size_ - back) & kMask] == key) {
             count += 1;
         }
     }
     return count;
 }
+
+// The same position with the same side to move cannot reappear earlier than four plies back.
+// A single occurrence before the root is only a twofold repetition of the game, not a draw.
+bool RepetitionHistory::HasRepetition(uint64_t key, uint32_t window, uint32_t plies_from_root) const {
+    const uint32_t limit = Window(window);
+
+    uint8_t pre_root = 0;
+    for (uint32_t back = 4; back <= limit; back += 2) {
+        if (keys_[(size_ - back) & kMask] != key) {
+            continue;
+        }
+
+        if (back <= plies_from_root || ++pre_root == 2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t RepetitionHistory::GetKey(uint32_t plies_back) const {
+    return keys_[(size_ - plies_back) & kMask];
+}
+
+uint32_t RepetitionHistory::GetSize() const {
+    return size_;
+}
@@ -1,30 +1,51 @@
 /************************************************
-* RepetitionHistory — tracks the history of Zobrist hashes
+* RepetitionHistory — tracks the history of Zobrist keys
 * to detect position repetition for draw conditions.
 *
-* Used by game logic to determine how many times
-* a position has occurred. Supports reset.
+* Fixed-capacity inline ring of raw keys (no heap, trivially copyable),
+* pushed on make and popped on unmake. Lookups scan backwards in steps
+* of two plies (same side to move) and stop at the last irreversible move.
+* Search lookups take the plies since the search root: one earlier
+* occurrence inside the search is a draw, game history before the root
+* needs two.
 *
 * Contains:
-* - AddPosition() for logging hashes
-* - GetRepetitionNumber() to count repeats
-* - Clear() to reset the history
+* - AddPosition()/RemoveLast() for make/unmake
+* - GetRepetitionNumber() / HasRepetition() bounded scans
+* - GetKey() for cuckoo cycle detection
+* - Clear() to reset the history on irreversible moves
 ************************************************/
 
 #pragma once
 
-#include <vector>
-#include "zobrist_hash.h"
+#include <array>
+#include <cstdint>
 
 class RepetitionHistory {
 public:
+    // Scans never go further back than 255 plies (the fifty-move counter range).
+    static constexpr uint32_t kCapacity = 256;
+
     RepetitionHistory() = default;
 
-    void AddPosition(ZobristHash hash);
+    void AddPosition(uint64_t key);
+    void RemoveLast();
     void Clear();
 
-    uint8_t GetRepetitionNumber(ZobristHash hash) const;
+    // Occurrences of 'key' among the previous 'window' plies with the same side to move.
+    uint8_t GetRepetitionNumber(uint64_t key, uint32_t window) const;
+    // Any occurrence within the last 'plies_from_root' plies, or two before them
+    bool HasRepetition(uint64_t key, uint32_t window, uint32_t plies_from_root) const;
+
+    // Key of the position 'plies_back' plies ago (1 = before the last move).
+    uint64_t GetKey(uint32_t plies_back) const;
+    uint32_t GetSize() const;
 
 private:
-    std::vector<ZobristHash> hashes_;
+    static constexpr uint32_t kMask = kCapacity - 1;
+
+    uint32_t Window(uint32_t window) const;
+
+    std::array<uint64_t, kCapacity> keys_{};
+    uint32_t size_ = 0;
 };
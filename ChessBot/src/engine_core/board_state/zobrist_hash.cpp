@@ -1,51 +1,10 @@
 #include "zobrist_hash.h"
 #include "bitboard.h"
-#include <random>
-#include <mutex>
-
-// Static members
-std::array<std::array<std::array<uint64_t, static_cast<int>(PieceType::Count)>, 2>, 64> ZobristHash::piece_keys_{};
-std::array<uint64_t, 8> ZobristHash::en_passant_file_keys_{};
-uint64_t ZobristHash::black_to_move_key_ = 0;
-uint64_t ZobristHash::white_long_castling_key_ = 0;
-uint64_t ZobristHash::white_short_castling_key_ = 0;
-uint64_t ZobristHash::black_long_castling_key_ = 0;
-uint64_t ZobristHash::black_short_castling_key_ = 0;
-
-std::once_flag ZobristHash::init_flag_;
-
-void ZobristHash::InitConstants() {
-    std::call_once(init_flag_, [] {
-        std::mt19937_64 rng(1337); // fixed seed for reproducibility
-        std::uniform_int_distribution<uint64_t> dist;
-
-        for (uint8_t sq = 0; sq < 64; ++sq) {
-            for (Side side : {Side::White, Side::Black}) {
-                for (PieceType type : {
-                                       PieceType::Pawn, PieceType::Knight, PieceType::Bishop,
-                                       PieceType::Rook, PieceType::Queen, PieceType::King }) {
-
-                    piece_keys_[sq][static_cast<int>(side)][static_cast<int>(type)] = dist(rng);
-                }
-            }
-        }
-
-        black_to_move_key_ = dist(rng);
-        white_long_castling_key_ = dist(rng);
-        white_short_castling_key_ = dist(rng);
-        black_long_castling_key_ = dist(rng);
-        black_short_castling_key_ = dist(rng);
-
-        for (int f = 0; f < 8; ++f) {
-            en_passant_file_keys_[f] = dist(rng);
-        }
-    });
-}
 
 ZobristHash::ZobristHash(Pieces pieces, bool black_to_move,
                          bool white_long, bool white_short,
                          bool black_long, bool black_short) {
-    InitConstants();
+    const ZobristKeys::KeySet& keys = ZobristKeys::kKeys;
 
     for (uint8_t sq = 0; sq < 64; ++sq) {
         for (Side side : {Side::White, Side::Black}) {
@@ -54,7 +13,7 @@ ZobristHash::ZobristHash(Pieces pieces, bool black_to_move,
                                    PieceType::Rook, PieceType::Queen, PieceType::King }) {
 
                 if (BOp::GetBit(pieces.GetPieceBitboard(side, type), sq)) {
-                    value_ ^= piece_keys_[sq][static_cast<int>(side)][static_cast<int>(type)];
+                    value_ ^= keys.pieces[sq][static_cast<int>(side)][static_cast<int>(type)];
                 }
             }
         }
@@ -66,39 +25,39 @@ ZobristHash::ZobristHash(Pieces pieces, bool black_to_move,
         }
     };
 
-    ApplyKey(black_to_move, black_to_move_key_);
-    ApplyKey(white_long, white_long_castling_key_);
-    ApplyKey(white_short, white_short_castling_key_);
-    ApplyKey(black_long, black_long_castling_key_);
-    ApplyKey(black_short, black_short_castling_key_);
+    ApplyKey(black_to_move, keys.black_to_move);
+    ApplyKey(white_long, keys.white_long_castling);
+    ApplyKey(white_short, keys.white_short_castling);
+    ApplyKey(black_long, keys.black_long_castling);
+    ApplyKey(black_short, keys.black_short_castling);
 }
 
 void ZobristHash::InvertPiece(uint8_t square, uint8_t type, uint8_t side) {
-    value_ ^= piece_keys_[square][side][type];
+    value_ ^= ZobristKeys::kKeys.pieces[square][side][type];
 }
 
 void ZobristHash::InvertMove() {
-    value_ ^= black_to_move_key_;
+    value_ ^= ZobristKeys::kKeys.black_to_move;
 }
 
 void ZobristHash::InvertWhiteLongCastling() {
-    value_ ^= white_long_castling_key_;
+    value_ ^= ZobristKeys::kKeys.white_long_castling;
 }
 
 void ZobristHash::InvertWhiteShortCastling() {
-    value_ ^= white_short_castling_key_;
+    value_ ^= ZobristKeys::kKeys.white_short_castling;
 }
 
 void ZobristHash::InvertBlackLongCastling() {
-    value_ ^= black_long_castling_key_;
+    value_ ^= ZobristKeys::kKeys.black_long_castling;
 }
 
 void ZobristHash::InvertBlackShortCastling() {
-    value_ ^= black_short_castling_key_;
+    value_ ^= ZobristKeys::kKeys.black_short_castling;
 }
 
 void ZobristHash::InvertEnPassantFile(uint8_t file) {
-    value_ ^= en_passant_file_keys_[file & 7];
+    value_ ^= ZobristKeys::kKeys.en_passant_files[file & 7];
 }
 
 uint64_t ZobristHash::GetValue() const {
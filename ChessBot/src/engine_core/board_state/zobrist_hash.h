@@ -8,16 +8,109 @@
 * Contains:
 * - Zobrist value
 * - XOR update methods (invert piece, move side, castling)
-* - Static Zobrist keys and one-time initialization
+* - Static Zobrist keys, generated at compile time by a constexpr
+*   xorshift64* generator from a fixed seed (no startup initialization)
+* - Fingerprint of the key set, to reject data hashed with other keys
 ************************************************/
 
 #pragma once
 
 #include <cstdint>
 #include <array>
-#include <mutex>
 #include "pieces.h"
 
+namespace ZobristKeys {
+
+// Seed of the key generator; changing it invalidates stored keys (e.g. TT snapshots)
+constexpr uint64_t kSeed = 1337;
+
+// xorshift64* pseudo-random generator, usable in constant expressions
+class Prng {
+public:
+    constexpr explicit Prng(uint64_t seed) : state_(seed) {}
+
+    constexpr uint64_t Next() {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 2685821657736338717ull;
+    }
+
+private:
+    uint64_t state_;
+};
+
+struct KeySet {
+    std::array<std::array<std::array<uint64_t, 6>, 2>, 64> pieces{}; // [square][side][type]
+    std::array<uint64_t, 8> en_passant_files{};
+    uint64_t black_to_move = 0;
+    uint64_t white_long_castling = 0;
+    uint64_t white_short_castling = 0;
+    uint64_t black_long_castling = 0;
+    uint64_t black_short_castling = 0;
+};
+
+// Draws the keys in a fixed order: pieces by square, side and type, then side to move,
+// castling rights and en-passant files
+constexpr KeySet Generate(uint64_t seed) {
+    Prng rng(seed);
+    KeySet keys;
+
+    for (auto& by_side : keys.pieces) {
+        for (auto& by_type : by_side) {
+            for (uint64_t& key : by_type) {
+                key = rng.Next();
+            }
+        }
+    }
+
+    keys.black_to_move = rng.Next();
+    keys.white_long_castling = rng.Next();
+    keys.white_short_castling = rng.Next();
+    keys.black_long_castling = rng.Next();
+    keys.black_short_castling = rng.Next();
+
+    for (uint64_t& key : keys.en_passant_files) {
+        key = rng.Next();
+    }
+
+    return keys;
+}
+
+// Hash of the seed and every key of the set
+constexpr uint64_t Fingerprint(const KeySet& keys, uint64_t seed) {
+    uint64_t hash = seed;
+    auto Mix = [&hash](uint64_t key) {
+        hash ^= key;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    };
+
+    for (const auto& by_side : keys.pieces) {
+        for (const auto& by_type : by_side) {
+            for (uint64_t key : by_type) {
+                Mix(key);
+            }
+        }
+    }
+
+    for (uint64_t key : keys.en_passant_files) {
+        Mix(key);
+    }
+
+    Mix(keys.black_to_move);
+    Mix(keys.white_long_castling);
+    Mix(keys.white_short_castling);
+    Mix(keys.black_long_castling);
+    Mix(keys.black_short_castling);
+
+    return hash;
+}
+
+inline constexpr KeySet kKeys = Generate(kSeed);
+
+} // namespace ZobristKeys
+
 class ZobristHash {
 public:
     ZobristHash() = default;
@@ -38,17 +131,22 @@ public:
 
     uint64_t GetValue() const;
 
-    static void InitConstants();
+    static constexpr uint64_t kSeed = ZobristKeys::kSeed;
+
+    // Hash of the seed and every generated key
+    static constexpr uint64_t Fingerprint() {
+        return ZobristKeys::Fingerprint(ZobristKeys::kKeys, kSeed);
+    }
+
+    // Raw keys, e.g. for precomputing move deltas
+    static constexpr uint64_t PieceKey(uint8_t square, uint8_t type, uint8_t side) {
+        return ZobristKeys::kKeys.pieces[square][side][type];
+    }
+
+    static constexpr uint64_t BlackToMoveKey() {
+        return ZobristKeys::kKeys.black_to_move;
+    }
 
 private:
     uint64_t value_ = 0;
-
-    static std::array<std::array<std::array<uint64_t, 6>, 2>, 64> piece_keys_;
-    static std::array<uint64_t, 8> en_passant_file_keys_;
-    static uint64_t black_to_move_key_;
-    static uint64_t white_long_castling_key_;
-    static uint64_t white_short_castling_key_;
-    static uint64_t black_long_castling_key_;
-    static uint64_t black_short_castling_key_;
-    static std::once_flag init_flag_;
 };
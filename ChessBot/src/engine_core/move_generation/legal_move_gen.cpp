@@ -2,6 +2,8 @@
 
 #include "ps_legal_move_mask_gen.h"
 #include "pawn_attack_masks.h"
+#include "knight_masks.h"
+#include "king_masks.h"
 
 // Fast lookup of defender piece type on square 'sq' for side def_side (or Move::None if empty)
 static inline uint8_t DefenderTypeAt(const Pieces& pcs, Side def_side, uint8_t sq) {
@@ -13,7 +15,7 @@ static inline uint8_t DefenderTypeAt(const Pieces& pcs, Side def_side, uint8_t s
     return Move::None;
 }
 
-// Adds a move (with legality check and promotion handling if needed)
+// Adds a move after the legality check
 void LegalMoveGen::TryPushMove(const Pieces& pcs, MoveList& out,
                                uint8_t from, uint8_t to,
                                PieceType attacker_type, Side attacker_side,
@@ -27,83 +29,114 @@ void LegalMoveGen::TryPushMove(const Pieces& pcs, MoveList& out,
         return;
     }
 
-    // Promotion: if 'to' is on the last rank
-    if (attacker_type == PieceType::Pawn && (to < 8 || to > 55)) {
-        out.Push({from, to, static_cast<uint8_t>(PieceType::Pawn), static_cast<uint8_t>(attacker_side),
-                  defender_type, defender_side, Move::Flag::PromoteToKnight});
-        out.Push({from, to, static_cast<uint8_t>(PieceType::Pawn), static_cast<uint8_t>(attacker_side),
-                  defender_type, defender_side, Move::Flag::PromoteToBishop});
-        out.Push({from, to, static_cast<uint8_t>(PieceType::Pawn), static_cast<uint8_t>(attacker_side),
-                  defender_type, defender_side, Move::Flag::PromoteToRook});
-        out.Push({from, to, static_cast<uint8_t>(PieceType::Pawn), static_cast<uint8_t>(attacker_side),
-                  defender_type, defender_side, Move::Flag::PromoteToQueen});
+    out.Push(m);
+}
+
+// Adds the four promotions of a pawn move to the last rank after one legality check
+void LegalMoveGen::TryPushPromotions(const Pieces& pcs, MoveList& out,
+                                     uint8_t from, uint8_t to, Side side,
+                                     uint8_t defender_type, uint8_t defender_side)
+{
+    const uint8_t pawn = static_cast<uint8_t>(PieceType::Pawn);
+    const uint8_t s = static_cast<uint8_t>(side);
+    const Move::Flag base_flag = (defender_type == Move::None) ? Move::Flag::Default : Move::Flag::Capture;
+
+    if (!LegalMoveGen::IsLegalAfterMove(pcs, Move{from, to, pawn, s, defender_type, defender_side, base_flag})) {
         return;
     }
 
-    out.Push(m);
+    out.Push({from, to, pawn, s, defender_type, defender_side, Move::Flag::PromoteToKnight});
+    out.Push({from, to, pawn, s, defender_type, defender_side, Move::Flag::PromoteToBishop});
+    out.Push({from, to, pawn, s, defender_type, defender_side, Move::Flag::PromoteToRook});
+    out.Push({from, to, pawn, s, defender_type, defender_side, Move::Flag::PromoteToQueen});
 }
 
 /*──────────────── Pawns ─────────────────*/
 
-// Pawn captures: iterate pawns
-void LegalMoveGen::GenPawnCaptures(const Pieces& pcs, Side side, MoveList& out) {
-    const Side enemy = Pieces::Inverse(side);
-    Bitboard pawns = pcs.GetPieceBitboard(side, PieceType::Pawn);
-
-    while (pawns) {
-        uint8_t from = BOp::BitScanForward(pawns);
-        pawns = BOp::Set_0(pawns, from);
-
-        Bitboard att = PawnMasks::kAttack[static_cast<int>(side)][from] & pcs.GetSideBoard(enemy);
-        while (att) {
-            uint8_t to = BOp::BitScanForward(att);
-            att = BOp::Set_0(att, to);
+// Pawn moves are generated set-wise: the whole pawn bitboard is shifted towards each target
+// (left/right capture, single/double push) and the origin of every target is a fixed offset away.
+namespace {
+
+constexpr Bitboard kNotFileA = 0xFEFEFEFEFEFEFEFEull;
+constexpr Bitboard kNotFileH = 0x7F7F7F7F7F7F7F7Full;
+constexpr Bitboard kRank1    = 0x00000000000000FFull;
+constexpr Bitboard kRank3    = 0x0000000000FF0000ull;
+constexpr Bitboard kRank6    = 0x0000FF0000000000ull;
+constexpr Bitboard kRank8    = 0xFF00000000000000ull;
+
+// Shift by a signed square offset (positive = towards rank 8)
+template <int Offset>
+constexpr Bitboard Shift(Bitboard bb) {
+    if constexpr (Offset > 0) {
+        return bb << Offset;
+    } else {
+        return bb >> -Offset;
+    }
+}
 
-            const uint8_t def_type = DefenderTypeAt(pcs, enemy, to);
-            // paranoia, but cheap
-            if (def_type == Move::None) {
-                continue;
+} // namespace
+
+// Pawn captures: per direction and per victim type, so the defender is known without a lookup
+template <Side S>
+void LegalMoveGen::GenPawnCaptures(const Pieces& pcs, Bitboard target, MoveList& out) {
+    constexpr Side enemy = Pieces::Inverse(S);
+    constexpr int kLeft  = (S == Side::White) ? 7 : -9;  // towards file a
+    constexpr int kRight = (S == Side::White) ? 9 : -7;  // towards file h
+    constexpr Bitboard kLastRank = (S == Side::White) ? kRank8 : kRank1;
+
+    const Bitboard pawns = pcs.GetPieceBitboard(S, PieceType::Pawn);
+    const Bitboard left  = Shift<kLeft>(pawns & kNotFileA) & target;
+    const Bitboard right = Shift<kRight>(pawns & kNotFileH) & target;
+
+    auto Emit = [&](Bitboard to_set, int offset) {
+        for (uint8_t pt = 0; pt < static_cast<uint8_t>(PieceType::Count); ++pt) {
+            Bitboard victims = to_set & pcs.GetPieceBitboard(enemy, static_cast<PieceType>(pt));
+
+            Bitboard promotions = victims & kLastRank;
+            victims &= ~kLastRank;
+            while (victims) {
+                const uint8_t to = BOp::PopLsb(victims);
+                TryPushMove(pcs, out, static_cast<uint8_t>(to - offset), to, PieceType::Pawn, S,
+                            pt, static_cast<uint8_t>(enemy), Move::Flag::Capture);
+            }
+            while (promotions) {
+                const uint8_t to = BOp::PopLsb(promotions);
+                TryPushPromotions(pcs, out, static_cast<uint8_t>(to - offset), to, S,
+                                  pt, static_cast<uint8_t>(enemy));
             }
-
-            TryPushMove(pcs, out, from, to, PieceType::Pawn, side,
-                        def_type, static_cast<uint8_t>(enemy), Move::Flag::Capture);
         }
-    }
+    };
+
+    Emit(left, kLeft);
+    Emit(right, kRight);
 }
 
-// Single/double pawn pushes: use precomputed 'to' masks from PsLegalMaskGen and restore 'from'
-void LegalMoveGen::GenPawnPushes(const Pieces& pcs, Side side, MoveList& out) {
-    // single: to = from ± 8
-    Bitboard single_to = PsLegalMaskGen::PawnSinglePush(pcs, side);
-    int8_t d1 = (side == Side::White) ? -8 : 8;
+// Single and double pawn pushes, promotions split off the single pushes
+template <Side S>
+void LegalMoveGen::GenPawnPushes(const Pieces& pcs, Bitboard target, MoveList& out) {
+    constexpr int kUp = (S == Side::White) ? 8 : -8;
+    constexpr Bitboard kLastRank  = (S == Side::White) ? kRank8 : kRank1;
+    constexpr Bitboard kThirdRank = (S == Side::White) ? kRank3 : kRank6;
 
-    while (single_to) {
-        uint8_t to = BOp::BitScanForward(single_to);
-        single_to = BOp::Set_0(single_to, to);
-        uint8_t from = static_cast<uint8_t>(to + d1);
+    const Bitboard empty = pcs.GetEmptyBitboard();
+    const Bitboard single = Shift<kUp>(pcs.GetPieceBitboard(S, PieceType::Pawn)) & empty;
 
-        if (!BOp::GetBit(pcs.GetPieceBitboard(side, PieceType::Pawn), from)) {
-            continue;
-        }
+    Bitboard dbl = Shift<kUp>(single & kThirdRank) & empty & target;
+    Bitboard promotions = single & target & kLastRank;
+    Bitboard pushes = single & target & ~kLastRank;
 
-        TryPushMove(pcs, out, from, to, PieceType::Pawn, side,
+    while (pushes) {
+        const uint8_t to = BOp::PopLsb(pushes);
+        TryPushMove(pcs, out, static_cast<uint8_t>(to - kUp), to, PieceType::Pawn, S,
                     Move::None, Move::None, Move::Flag::Default);
     }
-
-    // double: to = from ± 16
-    Bitboard dbl_to = PsLegalMaskGen::PawnDoublePush(pcs, side);
-    int8_t d2 = (side == Side::White) ? -16 : 16;
-
-    while (dbl_to) {
-        uint8_t to = BOp::BitScanForward(dbl_to);
-        dbl_to = BOp::Set_0(dbl_to, to);
-        uint8_t from = static_cast<uint8_t>(to + d2);
-
-        if (!BOp::GetBit(pcs.GetPieceBitboard(side, PieceType::Pawn), from)) {
-            continue;
-        }
-
-        TryPushMove(pcs, out, from, to, PieceType::Pawn, side,
+    while (promotions) {
+        const uint8_t to = BOp::PopLsb(promotions);
+        TryPushPromotions(pcs, out, static_cast<uint8_t>(to - kUp), to, S, Move::None, Move::None);
+    }
+    while (dbl) {
+        const uint8_t to = BOp::PopLsb(dbl);
+        TryPushMove(pcs, out, static_cast<uint8_t>(to - 2 * kUp), to, PieceType::Pawn, S,
                     Move::None, Move::None, Move::Flag::PawnLongMove);
     }
 }
@@ -133,6 +166,62 @@ void LegalMoveGen::PiecesMaskToMoves(const Pieces& pcs, Bitboard to_mask,
     }
 }
 
+template <Side S>
+void LegalMoveGen::GenPieceMoves(const Pieces& pcs, Bitboard target, MoveList& out) {
+    // Knights
+    Bitboard knights = pcs.GetPieceBitboard(S, PieceType::Knight);
+    while (knights) {
+        const uint8_t from = BOp::PopLsb(knights);
+        PiecesMaskToMoves(pcs, KnightMasks::kMasks[from] & target, from, PieceType::Knight, S, out);
+    }
+
+    // Bishops
+    Bitboard bishops = pcs.GetPieceBitboard(S, PieceType::Bishop);
+    while (bishops) {
+        const uint8_t from = BOp::PopLsb(bishops);
+        PiecesMaskToMoves(pcs, PsLegalMaskGen::BishopMask(pcs, from, S) & target, from, PieceType::Bishop, S, out);
+    }
+
+    // Rooks
+    Bitboard rooks = pcs.GetPieceBitboard(S, PieceType::Rook);
+    while (rooks) {
+        const uint8_t from = BOp::PopLsb(rooks);
+        PiecesMaskToMoves(pcs, PsLegalMaskGen::RookMask(pcs, from, S) & target, from, PieceType::Rook, S, out);
+    }
+
+    // Queens
+    Bitboard queens = pcs.GetPieceBitboard(S, PieceType::Queen);
+    while (queens) {
+        const uint8_t from = BOp::PopLsb(queens);
+        PiecesMaskToMoves(pcs, PsLegalMaskGen::QueenMask(pcs, from, S) & target, from, PieceType::Queen, S, out);
+    }
+}
+
+/*──────────────── Evasions ───────────────*/
+
+template <Side S>
+Bitboard LegalMoveGen::EvasionTargets(const Pieces& pcs, uint8_t king_square) {
+    const Bitboard checkers = PsLegalMaskGen::AttackersTo(pcs, king_square, pcs.GetAllBitboard()) &
+                              pcs.GetSideBoard(Pieces::Inverse(S));
+
+    if (checkers == 0) {
+        return ~Bitboard{0};
+    }
+    if (BOp::Count_1(checkers) > 1) {
+        return 0; // double check: only the king can move
+    }
+
+    // Capture the checker, or block a slider on the squares between it and the king
+    const uint8_t checker = BOp::BitScanForward(checkers);
+    for (uint8_t dir = 0; dir < SlidersMasks::Direction::Count; ++dir) {
+        const Bitboard ray = SlidersMasks::kMasks[king_square][dir];
+        if (BOp::GetBit(ray, checker)) {
+            return ray & ~SlidersMasks::kMasks[checker][dir];
+        }
+    }
+    return checkers;
+}
+
 /*──────────────── Legality ───────────────*/
 
 bool LegalMoveGen::IsLegalAfterMove(Pieces pcs, const Move& move) {
@@ -222,132 +311,405 @@ bool LegalMoveGen::IsLegalAfterMove(Pieces pcs, const Move& move) {
 
 /*──────────────── EP & Castling ───────────────*/
 
-void LegalMoveGen::AddEnPassantCaptures(const Pieces& pcs, Side side, uint8_t ep_square, MoveList& out) {
+template <Side S>
+void LegalMoveGen::AddEnPassantCaptures(const Pieces& pcs, uint8_t ep_square, MoveList& out) {
     if (ep_square == Position::NONE) return;
 
-    if (side == Side::White) {
-        if (ep_square % 8 != 7 && BOp::GetBit(pcs.GetPieceBitboard(Side::White, PieceType::Pawn), ep_square - 7)) {
+    const Bitboard pawns = pcs.GetPieceBitboard(S, PieceType::Pawn);
+    if constexpr (S == Side::White) {
+        if (ep_square % 8 != 7 && BOp::GetBit(pawns, ep_square - 7)) {
             TryPushMove(pcs, out, static_cast<uint8_t>(ep_square - 7), ep_square,
-                        PieceType::Pawn, Side::White, Move::None, Move::None, Move::Flag::EnPassantCapture);
+                        PieceType::Pawn, S, Move::None, Move::None, Move::Flag::EnPassantCapture);
         }
-        if (ep_square % 8 != 0 && BOp::GetBit(pcs.GetPieceBitboard(Side::White, PieceType::Pawn), ep_square - 9)) {
+        if (ep_square % 8 != 0 && BOp::GetBit(pawns, ep_square - 9)) {
             TryPushMove(pcs, out, static_cast<uint8_t>(ep_square - 9), ep_square,
-                        PieceType::Pawn, Side::White, Move::None, Move::None, Move::Flag::EnPassantCapture);
+                        PieceType::Pawn, S, Move::None, Move::None, Move::Flag::EnPassantCapture);
         }
     } else {
-        if (ep_square % 8 != 0 && BOp::GetBit(pcs.GetPieceBitboard(Side::Black, PieceType::Pawn), ep_square + 7)) {
+        if (ep_square % 8 != 0 && BOp::GetBit(pawns, ep_square + 7)) {
             TryPushMove(pcs, out, static_cast<uint8_t>(ep_square + 7), ep_square,
-                        PieceType::Pawn, Side::Black, Move::None, Move::None, Move::Flag::EnPassantCapture);
+                        PieceType::Pawn, S, Move::None, Move::None, Move::Flag::EnPassantCapture);
         }
-        if (ep_square % 8 != 7 && BOp::GetBit(pcs.GetPieceBitboard(Side::Black, PieceType::Pawn), ep_square + 9)) {
+        if (ep_square % 8 != 7 && BOp::GetBit(pawns, ep_square + 9)) {
             TryPushMove(pcs, out, static_cast<uint8_t>(ep_square + 9), ep_square,
-                        PieceType::Pawn, Side::Black, Move::None, Move::None, Move::Flag::EnPassantCapture);
+                        PieceType::Pawn, S, Move::None, Move::None, Move::Flag::EnPassantCapture);
         }
     }
 }
 
-void LegalMoveGen::AddCastlingMoves(const Pieces& pcs, Side side,
-                                    bool long_castle, bool short_castle, MoveList& out) {
-    const uint8_t base = (side == Side::White) ? 0 : 56;
-    const Move::Flag long_flag  = (side == Side::White) ? Move::Flag::WhiteLongCastling  : Move::Flag::BlackLongCastling;
-    const Move::Flag short_flag = (side == Side::White) ? Move::Flag::WhiteShortCastling : Move::Flag::BlackShortCastling;
+template <Side S>
+void LegalMoveGen::AddCastlingMoves(const Pieces& pcs, bool long_castle, bool short_castle, MoveList& out) {
+    constexpr uint8_t base = (S == Side::White) ? 0 : 56;
+    constexpr Move::Flag long_flag  = (S == Side::White) ? Move::Flag::WhiteLongCastling  : Move::Flag::BlackLongCastling;
+    constexpr Move::Flag short_flag = (S == Side::White) ? Move::Flag::WhiteShortCastling : Move::Flag::BlackShortCastling;
 
-    const uint8_t king_from = BOp::BitScanForward(pcs.GetPieceBitboard(side, PieceType::King));
+    const uint8_t king_from = BOp::BitScanForward(pcs.GetPieceBitboard(S, PieceType::King));
 
     // do not generate castling if the king is not on e1/e8
     if (king_from != uint8_t(base + 4)) {
         return;
     }
 
+    const Bitboard occupancy = pcs.GetAllBitboard();
+    const Bitboard enemy = pcs.GetSideBoard(Pieces::Inverse(S));
+    auto Attacked = [&](uint8_t sq) {
+        return (PsLegalMaskGen::AttackersTo(pcs, sq, occupancy) & enemy) != 0;
+    };
+
     // O-O-O
     if (long_castle &&
-        BOp::GetBit(pcs.GetPieceBitboard(side, PieceType::Rook), base + 0) &&
+        BOp::GetBit(pcs.GetPieceBitboard(S, PieceType::Rook), base + 0) &&
         BOp::GetBit(pcs.GetEmptyBitboard(), base + 1) &&
         BOp::GetBit(pcs.GetEmptyBitboard(), base + 2) &&
         BOp::GetBit(pcs.GetEmptyBitboard(), base + 3) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, king_from, side) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, base + 3, side) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, base + 2, side)) {
+        !Attacked(king_from) && !Attacked(base + 3) && !Attacked(base + 2)) {
 
         TryPushMove(pcs, out, uint8_t(base+4), uint8_t(base+2),
-                    PieceType::King, side, Move::None, Move::None, long_flag);
+                    PieceType::King, S, Move::None, Move::None, long_flag);
     }
 
     // O-O
     if (short_castle &&
-        BOp::GetBit(pcs.GetPieceBitboard(side, PieceType::Rook), base + 7) &&
+        BOp::GetBit(pcs.GetPieceBitboard(S, PieceType::Rook), base + 7) &&
         BOp::GetBit(pcs.GetEmptyBitboard(), base + 5) &&
         BOp::GetBit(pcs.GetEmptyBitboard(), base + 6) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, king_from, side) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, base + 5, side) &&
-        !PsLegalMaskGen::SquareInDanger(pcs, base + 6, side)) {
+        !Attacked(king_from) && !Attacked(base + 5) && !Attacked(base + 6)) {
 
         TryPushMove(pcs, out, uint8_t(base+4), uint8_t(base+6),
-                    PieceType::King, side, Move::None, Move::None, short_flag);
+                    PieceType::King, S, Move::None, Move::None, short_flag);
     }
 }
 
 /*──────────────── Entry point ───────────────*/
 
-void LegalMoveGen::Generate(const Position& position, Side side, MoveList& out, bool only_captures) {
+template <Side S, GenType T>
+void LegalMoveGen::Generate(const Position& position, MoveList& out) {
     out = MoveList{}; // reset
     const Pieces& pcs = position.GetPieces();
 
-    // Pawns
-    GenPawnCaptures(pcs, side, out);
-    if (!only_captures)
-        GenPawnPushes(pcs, side, out);
-
-    // Knights
-    Bitboard knights = pcs.GetPieceBitboard(side, PieceType::Knight);
-    while (knights) {
-        uint8_t from = BOp::BitScanForward(knights);
-        knights = BOp::Set_0(knights, from);
-        Bitboard mask = PsLegalMaskGen::KnightMask(pcs, from, side, only_captures);
-        PiecesMaskToMoves(pcs, mask, from, PieceType::Knight, side, out);
+    if constexpr (T == GenType::QuietChecks) {
+        AppendQuietChecks<S>(position, out);
+        return;
     }
 
-    // Bishops
-    Bitboard bishops = pcs.GetPieceBitboard(side, PieceType::Bishop);
-    while (bishops) {
-        uint8_t from = BOp::BitScanForward(bishops);
-        bishops = BOp::Set_0(bishops, from);
-        Bitboard mask = PsLegalMaskGen::BishopMask(pcs, from, side, only_captures);
-        PiecesMaskToMoves(pcs, mask, from, PieceType::Bishop, side, out);
+    const uint8_t k_from = BOp::BitScanForward(pcs.GetPieceBitboard(S, PieceType::King));
+
+    // Squares the pieces may move to; the king always uses the unrestricted mask of its kind
+    const Bitboard enemy = pcs.GetSideBoard(Pieces::Inverse(S));
+    Bitboard target = 0;
+    Bitboard king_target = 0;
+    if constexpr (T == GenType::Captures) {
+        target = king_target = enemy;
+    } else if constexpr (T == GenType::Quiets) {
+        target = king_target = pcs.GetEmptyBitboard();
+    } else if constexpr (T == GenType::All) {
+        target = king_target = pcs.GetInvSideBitboard(S);
+    } else if constexpr (T == GenType::Evasions) {
+        king_target = pcs.GetInvSideBitboard(S);
+        target = king_target & EvasionTargets<S>(pcs, k_from);
+        if (target == king_target) {
+            Generate<S, GenType::All>(position, out); // not in check
+            return;
+        }
     }
 
-    // Rooks
-    Bitboard rooks = pcs.GetPieceBitboard(side, PieceType::Rook);
-    while (rooks) {
-        uint8_t from = BOp::BitScanForward(rooks);
-        rooks = BOp::Set_0(rooks, from);
-        Bitboard mask = PsLegalMaskGen::RookMask(pcs, from, side, only_captures);
-        PiecesMaskToMoves(pcs, mask, from, PieceType::Rook, side, out);
+    // Pawns
+    if constexpr (T != GenType::Quiets) {
+        GenPawnCaptures<S>(pcs, target, out);
+    }
+    if constexpr (T != GenType::Captures) {
+        GenPawnPushes<S>(pcs, target, out);
     }
 
-    // Queens
-    Bitboard queens = pcs.GetPieceBitboard(side, PieceType::Queen);
-    while (queens) {
-        uint8_t from = BOp::BitScanForward(queens);
-        queens = BOp::Set_0(queens, from);
-        Bitboard mask = PsLegalMaskGen::QueenMask(pcs, from, side, only_captures);
-        PiecesMaskToMoves(pcs, mask, from, PieceType::Queen, side, out);
+    // Knights, bishops, rooks, queens
+    if (target) {
+        GenPieceMoves<S>(pcs, target, out);
     }
 
     // King
-    uint8_t k_from = BOp::BitScanForward(pcs.GetPieceBitboard(side, PieceType::King));
-    Bitboard k_mask = PsLegalMaskGen::KingMask(pcs, k_from, side, only_captures);
-    PiecesMaskToMoves(pcs, k_mask, k_from, PieceType::King, side, out);
+    PiecesMaskToMoves(pcs, KingMasks::kMasks[k_from] & king_target, k_from, PieceType::King, S, out);
 
-    // En-Passant
-    AddEnPassantCaptures(pcs, side, position.GetEnPassantSquare(), out);
+    // En-Passant (as an evasion it may capture a checking pawn; legality decides)
+    if constexpr (T != GenType::Quiets) {
+        AddEnPassantCaptures<S>(pcs, position.GetEnPassantSquare(), out);
+    }
 
     // Castling
-    if (!only_captures) {
-        if (side == Side::White) {
-            AddCastlingMoves(pcs, Side::White, position.GetWhiteLongCastling(), position.GetWhiteShortCastling(), out);
+    if constexpr (T == GenType::Quiets || T == GenType::All) {
+        if constexpr (S == Side::White) {
+            AddCastlingMoves<S>(pcs, position.GetWhiteLongCastling(), position.GetWhiteShortCastling(), out);
         } else {
-            AddCastlingMoves(pcs, Side::Black, position.GetBlackLongCastling(), position.GetBlackShortCastling(), out);
+            AddCastlingMoves<S>(pcs, position.GetBlackLongCastling(), position.GetBlackShortCastling(), out);
+        }
+    }
+}
+
+void LegalMoveGen::Generate(const Position& position, Side side, GenType type, MoveList& out) {
+    if (side == Side::White) {
+        switch (type) {
+        case GenType::Captures:    Generate<Side::White, GenType::Captures>(position, out); break;
+        case GenType::Quiets:      Generate<Side::White, GenType::Quiets>(position, out); break;
+        case GenType::Evasions:    Generate<Side::White, GenType::Evasions>(position, out); break;
+        case GenType::QuietChecks: Generate<Side::White, GenType::QuietChecks>(position, out); break;
+        case GenType::All:         Generate<Side::White, GenType::All>(position, out); break;
+        }
+    } else {
+        switch (type) {
+        case GenType::Captures:    Generate<Side::Black, GenType::Captures>(position, out); break;
+        case GenType::Quiets:      Generate<Side::Black, GenType::Quiets>(position, out); break;
+        case GenType::Evasions:    Generate<Side::Black, GenType::Evasions>(position, out); break;
+        case GenType::QuietChecks: Generate<Side::Black, GenType::QuietChecks>(position, out); break;
+        case GenType::All:         Generate<Side::Black, GenType::All>(position, out); break;
+        }
+    }
+}
+
+void LegalMoveGen::Generate(const Position& position, Side side, MoveList& out, bool only_captures) {
+    Generate(position, side, only_captures ? GenType::Captures : GenType::All, out);
+}
+
+/*──────────────── Quiet checks ───────────────*/
+
+template <Side S>
+Bitboard LegalMoveGen::QuietTargets(const Pieces& pcs, uint8_t from, PieceType type) {
+    const Bitboard empty = pcs.GetEmptyBitboard();
+
+    switch (type) {
+    case PieceType::Pawn: {
+        const Bitboard last_ranks = BRows::Rows[0] | BRows::Rows[7];
+        constexpr int step = (S == Side::White) ? 8 : -8;
+        const uint8_t one = static_cast<uint8_t>(from + step);
+
+        if (!BOp::GetBit(empty, one) || BOp::GetBit(last_ranks, one)) {
+            return 0;
+        }
+
+        Bitboard targets = BOp::Set_1(0, one);
+        constexpr uint8_t start_rank = (S == Side::White) ? 1 : 6;
+        const uint8_t two = static_cast<uint8_t>(from + 2 * step);
+        if (from / 8 == start_rank && BOp::GetBit(empty, two)) {
+            targets = BOp::Set_1(targets, two);
         }
+        return targets;
+    }
+    case PieceType::Knight:
+        return PsLegalMaskGen::KnightMask(pcs, from, S) & empty;
+    case PieceType::Bishop:
+        return PsLegalMaskGen::BishopMask(pcs, from, S) & empty;
+    case PieceType::Rook:
+        return PsLegalMaskGen::RookMask(pcs, from, S) & empty;
+    case PieceType::Queen:
+        return PsLegalMaskGen::QueenMask(pcs, from, S) & empty;
+    case PieceType::King:
+        return PsLegalMaskGen::KingMask(pcs, from, S) & empty;
+    default:
+        return 0;
     }
 }
+
+void LegalMoveGen::GenerateQuietChecks(const Position& position, Side side, MoveList& out) {
+    if (side == Side::White) {
+        AppendQuietChecks<Side::White>(position, out);
+    } else {
+        AppendQuietChecks<Side::Black>(position, out);
+    }
+}
+
+template <Side S>
+void LegalMoveGen::AppendQuietChecks(const Position& position, MoveList& out) {
+    const Pieces& pcs = position.GetPieces();
+    constexpr Side enemy = Pieces::Inverse(S);
+
+    const Bitboard enemy_king = pcs.GetPieceBitboard(enemy, PieceType::King);
+    if (enemy_king == 0) {
+        return;
+    }
+    const uint8_t ksq = BOp::BitScanForward(enemy_king);
+
+    // Check squares: where a piece of each type would attack the king (sliders use current occupancy)
+    std::array<Bitboard, static_cast<int>(PieceType::Count)> check_squares{};
+    check_squares[PieceType::Pawn]   = PawnMasks::kAttack[static_cast<int>(enemy)][ksq];
+    check_squares[PieceType::Knight] = KnightMasks::kMasks[ksq];
+    check_squares[PieceType::Bishop] = PsLegalMaskGen::BishopMask(pcs, ksq, enemy);
+    check_squares[PieceType::Rook]   = PsLegalMaskGen::RookMask(pcs, ksq, enemy);
+    check_squares[PieceType::Queen]  = check_squares[PieceType::Bishop] | check_squares[PieceType::Rook];
+
+    // Discovered-check blockers: own piece that is the only one between the king and an own slider.
+    // The blocker must leave the king's ray in that direction.
+    std::array<Bitboard, 64> leave_ray{};
+    Bitboard blockers = 0;
+
+    using D = SlidersMasks::Direction;
+    for (uint8_t dir = 0; dir < D::Count; ++dir) {
+        const Bitboard ray = SlidersMasks::kMasks[ksq][dir];
+        const Bitboard occ = ray & pcs.GetAllBitboard();
+        if (occ == 0) {
+            continue;
+        }
+
+        const bool reverse = (dir == D::South || dir == D::West || dir == D::SouthWest || dir == D::SouthEast);
+        const uint8_t first = reverse ? BOp::BitScanReverse(occ) : BOp::BitScanForward(occ);
+        if (!BOp::GetBit(pcs.GetSideBoard(S), first)) {
+            continue;
+        }
+
+        const Bitboard behind = SlidersMasks::kMasks[first][dir] & pcs.GetAllBitboard();
+        if (behind == 0) {
+            continue;
+        }
+
+        const uint8_t second = reverse ? BOp::BitScanReverse(behind) : BOp::BitScanForward(behind);
+        const bool diagonal = (dir >= D::NorthWest);
+        const Bitboard sliders = pcs.GetPieceBitboard(S, PieceType::Queen) |
+                                 pcs.GetPieceBitboard(S, diagonal ? PieceType::Bishop : PieceType::Rook);
+
+        if (BOp::GetBit(sliders, second)) {
+            blockers = BOp::Set_1(blockers, first);
+            leave_ray[first] = ray;
+        }
+    }
+
+    for (uint8_t pt = 0; pt < static_cast<uint8_t>(PieceType::Count); ++pt) {
+        const PieceType type = static_cast<PieceType>(pt);
+        Bitboard own = pcs.GetPieceBitboard(S, type);
+
+        while (own) {
+            const uint8_t from = BOp::PopLsb(own);
+            const Bitboard quiet = QuietTargets<S>(pcs, from, type);
+
+            Bitboard targets = (type == PieceType::King) ? 0 : (quiet & check_squares[pt]);
+            if (BOp::GetBit(blockers, from)) {
+                targets |= quiet & ~leave_ray[from];
+            }
+
+            while (targets) {
+                const uint8_t to = BOp::PopLsb(targets);
+                const bool long_move = (type == PieceType::Pawn) && (to == from + 16 || from == to + 16);
+
+                TryPushMove(pcs, out, from, to, type, S, Move::None, Move::None,
+                            long_move ? Move::Flag::PawnLongMove : Move::Flag::Default);
+            }
+        }
+    }
+}
+
+/*──────────────── Any legal move ───────────────*/
+
+bool LegalMoveGen::AnyLegalFrom(const Pieces& pcs, uint8_t from, Bitboard to_mask,
+                                PieceType attacker_type, Side attacker_side)
+{
+    const Side enemy = Pieces::Inverse(attacker_side);
+
+    while (to_mask) {
+        const uint8_t to = BOp::PopLsb(to_mask);
+        const uint8_t def_type = DefenderTypeAt(pcs, enemy, to);
+        const uint8_t def_side = (def_type == Move::None) ? Move::None : static_cast<uint8_t>(enemy);
+
+        // Promotions and long pawn moves are legal exactly when the plain move is
+        const Move m{from, to, static_cast<uint8_t>(attacker_type), static_cast<uint8_t>(attacker_side),
+                     def_type, def_side, (def_type == Move::None) ? Move::Flag::Default : Move::Flag::Capture};
+        if (IsLegalAfterMove(pcs, m)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <Side S>
+bool LegalMoveGen::HasAnyLegalMove(const Position& position) {
+    const Pieces& pcs = position.GetPieces();
+    const Bitboard own_inv = pcs.GetInvSideBitboard(S);
+    const uint8_t k_from = BOp::BitScanForward(pcs.GetPieceBitboard(S, PieceType::King));
+
+    // King first: it answers every check kind and is the only piece allowed to move in double check.
+    // Castling needs no test of its own: when it is legal, so is the king's step towards the rook.
+    if (AnyLegalFrom(pcs, k_from, KingMasks::kMasks[k_from] & own_inv, PieceType::King, S)) {
+        return true;
+    }
+
+    const Bitboard target = own_inv & EvasionTargets<S>(pcs, k_from);
+    if (target) {
+        Bitboard knights = pcs.GetPieceBitboard(S, PieceType::Knight);
+        while (knights) {
+            const uint8_t from = BOp::PopLsb(knights);
+            if (AnyLegalFrom(pcs, from, KnightMasks::kMasks[from] & target, PieceType::Knight, S)) {
+                return true;
+            }
+        }
+
+        Bitboard bishops = pcs.GetPieceBitboard(S, PieceType::Bishop);
+        while (bishops) {
+            const uint8_t from = BOp::PopLsb(bishops);
+            if (AnyLegalFrom(pcs, from, PsLegalMaskGen::BishopMask(pcs, from, S) & target, PieceType::Bishop, S)) {
+                return true;
+            }
+        }
+
+        Bitboard rooks = pcs.GetPieceBitboard(S, PieceType::Rook);
+        while (rooks) {
+            const uint8_t from = BOp::PopLsb(rooks);
+            if (AnyLegalFrom(pcs, from, PsLegalMaskGen::RookMask(pcs, from, S) & target, PieceType::Rook, S)) {
+                return true;
+            }
+        }
+
+        Bitboard queens = pcs.GetPieceBitboard(S, PieceType::Queen);
+        while (queens) {
+            const uint8_t from = BOp::PopLsb(queens);
+            if (AnyLegalFrom(pcs, from, PsLegalMaskGen::QueenMask(pcs, from, S) & target, PieceType::Queen, S)) {
+                return true;
+            }
+        }
+
+        // Pawns: captures and single/double pushes of each pawn
+        constexpr int kUp = (S == Side::White) ? 8 : -8;
+        constexpr uint8_t kStartRank = (S == Side::White) ? 1 : 6;
+        const Bitboard empty = pcs.GetEmptyBitboard();
+        const Bitboard enemy = pcs.GetSideBoard(Pieces::Inverse(S));
+
+        Bitboard pawns = pcs.GetPieceBitboard(S, PieceType::Pawn);
+        while (pawns) {
+            const uint8_t from = BOp::PopLsb(pawns);
+            Bitboard to_mask = PawnMasks::kAttack[static_cast<int>(S)][from] & enemy;
+
+            const uint8_t one = static_cast<uint8_t>(from + kUp);
+            if (BOp::GetBit(empty, one)) {
+                to_mask = BOp::Set_1(to_mask, one);
+                const uint8_t two = static_cast<uint8_t>(from + 2 * kUp);
+                if (from / 8 == kStartRank && BOp::GetBit(empty, two)) {
+                    to_mask = BOp::Set_1(to_mask, two);
+                }
+            }
+
+            if (AnyLegalFrom(pcs, from, to_mask & target, PieceType::Pawn, S)) {
+                return true;
+            }
+        }
+    }
+
+    // En passant may remove a checking pawn off the target squares; legality decides
+    if (position.GetEnPassantSquare() == Position::NONE) {
+        return false;
+    }
+    MoveList ep;
+    AddEnPassantCaptures<S>(pcs, position.GetEnPassantSquare(), ep);
+    return ep.GetSize() != 0;
+}
+
+bool LegalMoveGen::HasAnyLegalMove(const Position& position) {
+    return position.IsWhiteToMove() ? HasAnyLegalMove<Side::White>(position)
+                                    : HasAnyLegalMove<Side::Black>(position);
+}
+
+template void LegalMoveGen::Generate<Side::White, GenType::Captures>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::White, GenType::Quiets>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::White, GenType::Evasions>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::White, GenType::QuietChecks>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::White, GenType::All>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::Black, GenType::Captures>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::Black, GenType::Quiets>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::Black, GenType::Evasions>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::Black, GenType::QuietChecks>(const Position&, MoveList&);
+template void LegalMoveGen::Generate<Side::Black, GenType::All>(const Position&, MoveList&);
+template bool LegalMoveGen::HasAnyLegalMove<Side::White>(const Position&);
+template bool LegalMoveGen::HasAnyLegalMove<Side::Black>(const Position&);
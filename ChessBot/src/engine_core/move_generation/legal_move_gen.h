@@ -1,7 +1,11 @@
 /************
 * LegalMoveGen is responsible for generating fully legal chess moves for a given side.
 * It relies on pseudo-legal move masks and then filters out moves that leave the king in check.
-* Pawn captures are handled separately to avoid file wrap issues and to leverage precomputed attack masks.
+* Pawn moves are generated set-wise: the pawn bitboard is shifted (with file masks against wrap) and
+* origins are recovered from fixed offsets.
+* Generation is templated on the side and the kind of moves (GenType), so side and capture/quiet
+* branches are resolved at compile time; the runtime overloads only dispatch to the instantiations.
+* HasAnyLegalMove answers the terminal-node question (mate/stalemate) without building a move list.
 ************/
 
 #pragma once
@@ -10,33 +14,86 @@
 #include "../board_state/move.h"
 #include "move_list.h"
 
+enum class GenType : uint8_t {
+    Captures,    // captures, capture-promotions and en passant
+    Quiets,      // every other move: pushes, quiet promotions, piece moves, castling (Captures + Quiets = All)
+    Evasions,    // moves out of check: king moves, captures of the checker, blocks; All when not in check
+    QuietChecks, // quiet moves that give check, see GenerateQuietChecks
+    All
+};
+
 class LegalMoveGen {
 public:
+    // Fills 'out' with the legal moves of the given kind for side S.
+    template <Side S, GenType T>
+    static void Generate(const Position& position, MoveList& out);
+
+    // Runtime dispatchers to Generate<S, T>
+    static void Generate(const Position& position, Side side, GenType type, MoveList& out);
+
     // Fills 'out' with all legal moves for the given side.
     // If only_captures is true, generates only capture moves (including en passant).
     static void Generate(const Position& position, Side side, MoveList& out, bool only_captures = false);
 
+    // Appends legal quiet moves (no captures, promotions or castling) that give check:
+    // direct checks onto the enemy king's check squares and discovered checks.
+    static void GenerateQuietChecks(const Position& position, Side side, MoveList& out);
+
+    // True if side S has at least one legal move. Returns on the first legal move found, trying
+    // the king first, then knights, sliders and pawns.
+    template <Side S>
+    static bool HasAnyLegalMove(const Position& position);
+
+    // Same for the side to move
+    static bool HasAnyLegalMove(const Position& position);
+
 private:
     // Converters from bit masks to moves for non-pawn pieces.
     static void PiecesMaskToMoves(const Pieces& pcs, Bitboard to_mask,
                                   uint8_t from_sq, PieceType attacker_type,
                                   Side attacker_side, MoveList& out);
 
-    // Pawn moves: simple forward pushes and captures without using coordinate deltas.
-    static void GenPawnCaptures (const Pieces& pcs, Side side, MoveList& out);
-    static void GenPawnPushes  (const Pieces& pcs, Side side, MoveList& out);
+    // Pawn moves, generated set-wise from shifted pawn bitboards.
+    // Only moves landing on 'target' are generated (evasions: checker square and blocking squares).
+    template <Side S>
+    static void GenPawnCaptures(const Pieces& pcs, Bitboard target, MoveList& out);
+    template <Side S>
+    static void GenPawnPushes(const Pieces& pcs, Bitboard target, MoveList& out);
+
+    // Knights, bishops, rooks and queens moving onto 'target'
+    template <Side S>
+    static void GenPieceMoves(const Pieces& pcs, Bitboard target, MoveList& out);
+
+    // Squares a non-king move must land on to answer check (0 on double check, all when not in check)
+    template <Side S>
+    static Bitboard EvasionTargets(const Pieces& pcs, uint8_t king_square);
+
+    // Quiet (empty-square) targets of a piece; pawns get single and double pushes without promotions.
+    template <Side S>
+    static Bitboard QuietTargets(const Pieces& pcs, uint8_t from, PieceType type);
+
+    template <Side S>
+    static void AppendQuietChecks(const Position& position, MoveList& out);
+
+    // True if one of the moves of the piece on 'from' onto to_mask is legal
+    static bool AnyLegalFrom(const Pieces& pcs, uint8_t from, Bitboard to_mask,
+                             PieceType attacker_type, Side attacker_side);
 
     // Checks if the move is legal after applying it on a copy of Pieces.
     static bool IsLegalAfterMove(Pieces pcs, const Move& move);
 
     // Special moves: en passant and castling.
-    static void AddEnPassantCaptures(const Pieces& pcs, Side side, uint8_t ep_square, MoveList& out);
-    static void AddCastlingMoves   (const Pieces& pcs, Side side,
-                                 bool long_castle, bool short_castle, MoveList& out);
+    template <Side S>
+    static void AddEnPassantCaptures(const Pieces& pcs, uint8_t ep_square, MoveList& out);
+    template <Side S>
+    static void AddCastlingMoves(const Pieces& pcs, bool long_castle, bool short_castle, MoveList& out);
 
     static inline void TryPushMove(const Pieces& pcs, MoveList& out,
                                    uint8_t from, uint8_t to,
                                    PieceType attacker_type, Side attacker_side,
                                    uint8_t defender_type, uint8_t defender_side,
                                    Move::Flag flag);
+    static void TryPushPromotions(const Pieces& pcs, MoveList& out,
+                                  uint8_t from, uint8_t to, Side side,
+                                  uint8_t defender_type, uint8_t defender_side);
 };
@@ -13,6 +13,8 @@
 
 class MoveList {
 public:
+    static constexpr std::size_t kMaxMoves = 218;  // Maximum legal move count in chess
+
     MoveList();
 
     // Returns reference to move at given index
@@ -43,6 +45,6 @@ public:
     }
 
 private:
-    std::array<Move, 218> moves_{};  // Maximum legal move count in chess
+    std::array<Move, kMaxMoves> moves_{};
     std::uint8_t size_ = 0;
 };
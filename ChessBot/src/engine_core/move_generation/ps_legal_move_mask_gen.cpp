@@ -97,59 +97,57 @@ Bitboard PsLegalMaskGen::QueenMask(const Pieces& pcs, uint8_t sq, Side s, bool o
            RookMask  (pcs, sq, s, only_captures);
 }
 
-/*────────────── King safety ──────────────*/
-
-bool PsLegalMaskGen::SquareInDanger(const Pieces& pcs, uint8_t sq, Side s) {
-    Side enemy = Pieces::Inverse(s);
+/*────────────── Attacks ──────────────*/
 
-    Bitboard enemyPawns = pcs.GetPieceBitboard(enemy, PieceType::Pawn);
-
-    // Iterate over all enemy pawns
-    while (enemyPawns) {
-        // pawn square index
-        uint8_t pawnSq = BOp::BitScanForward(enemyPawns);
-        // its attack mask
-        Bitboard pawnAtt =
-            PawnMasks::kAttack[static_cast<int>(enemy)][pawnSq];
-
-        // does it attack square sq?
-        if (pawnAtt & (1ULL << sq)) {
-            return true;
-        }
+namespace {
 
-        // move to the next pawn
-        enemyPawns = BOp::Set_0(enemyPawns, pawnSq);
+// Ray from sq in dir up to and including the first occupied square
+template <SlidersMasks::Direction Dir, bool Reverse>
+inline Bitboard RayAttacks(uint8_t sq, Bitboard occupancy) {
+    Bitboard ray = SlidersMasks::kMasks[sq][Dir];
+    const Bitboard blockers = ray & occupancy;
+    if (blockers) {
+        const uint8_t block_sq = Reverse ? BOp::BitScanReverse(blockers) : BOp::BitScanForward(blockers);
+        ray ^= SlidersMasks::kMasks[block_sq][Dir];
     }
+    return ray;
+}
 
-    // if (PawnMasks::kAttack[static_cast<int>(enemy)][sq] &
-    //     pcs.GetPieceBitboard(enemy, PieceType::Pawn)) {
-    //     return true;
-    // }
+} // namespace
 
-    if (KnightMask(pcs, sq, s, true) &
-        pcs.GetPieceBitboard(enemy, PieceType::Knight)) {
-        return true;
-    }
-
-    if (BishopMask(pcs, sq, s, true) &
-        pcs.GetPieceBitboard(enemy, PieceType::Bishop)) {
-        return true;
-    }
+Bitboard PsLegalMaskGen::BishopAttacks(uint8_t sq, Bitboard occupancy) {
+    using D = SlidersMasks::Direction;
+    return RayAttacks<D::NorthWest, false>(sq, occupancy) |
+           RayAttacks<D::NorthEast, false>(sq, occupancy) |
+           RayAttacks<D::SouthWest, true >(sq, occupancy) |
+           RayAttacks<D::SouthEast, true >(sq, occupancy);
+}
 
-    if (RookMask(pcs, sq, s, true) &
-        pcs.GetPieceBitboard(enemy, PieceType::Rook)) {
-        return true;
-    }
+Bitboard PsLegalMaskGen::RookAttacks(uint8_t sq, Bitboard occupancy) {
+    using D = SlidersMasks::Direction;
+    return RayAttacks<D::North, false>(sq, occupancy) |
+           RayAttacks<D::South, true >(sq, occupancy) |
+           RayAttacks<D::West , true >(sq, occupancy) |
+           RayAttacks<D::East , false>(sq, occupancy);
+}
 
-    if (QueenMask(pcs, sq, s, true) &
-        pcs.GetPieceBitboard(enemy, PieceType::Queen)) {
-        return true;
-    }
+Bitboard PsLegalMaskGen::AttackersTo(const Pieces& pcs, uint8_t sq, Bitboard occupancy) {
+    auto Both = [&pcs](PieceType type) {
+        return pcs.GetPieceBitboard(Side::White, type) | pcs.GetPieceBitboard(Side::Black, type);
+    };
+    const Bitboard queens = Both(PieceType::Queen);
+
+    // A pawn of one side attacks sq from the squares a pawn of the other side on sq would attack
+    return (PawnMasks::kAttack[static_cast<int>(Side::Black)][sq] & pcs.GetPieceBitboard(Side::White, PieceType::Pawn)) |
+           (PawnMasks::kAttack[static_cast<int>(Side::White)][sq] & pcs.GetPieceBitboard(Side::Black, PieceType::Pawn)) |
+           (KnightMasks::kMasks[sq] & Both(PieceType::Knight)) |
+           (KingMasks::kMasks[sq]   & Both(PieceType::King))   |
+           (BishopAttacks(sq, occupancy) & (Both(PieceType::Bishop) | queens)) |
+           (RookAttacks(sq, occupancy)   & (Both(PieceType::Rook)   | queens));
+}
 
-    if (KingMask(pcs, sq, s, true) &
-        pcs.GetPieceBitboard(enemy, PieceType::King)) {
-        return true;
-    }
+/*────────────── King safety ──────────────*/
 
-    return false;
+bool PsLegalMaskGen::SquareInDanger(const Pieces& pcs, uint8_t sq, Side s) {
+    return (AttackersTo(pcs, sq, pcs.GetAllBitboard()) & pcs.GetSideBoard(Pieces::Inverse(s))) != 0;
 }
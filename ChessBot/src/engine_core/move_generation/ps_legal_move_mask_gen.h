@@ -2,7 +2,8 @@
 * ps_legal_move_mask_gen.h
 *
 * Helpers that build pseudo‑legal move masks (no check test)
-* for every piece.  Used by move‑generation and threat checks.
+* for every piece, and the attackers-to-square primitive behind
+* check detection, castling, SEE and evaluation threats.
 **********************************************************/
 
 #pragma once
@@ -31,7 +32,17 @@ public:
     static Bitboard QueenMask(const Pieces& pcs, uint8_t sq, Side s,
                               bool only_captures = false);
 
+    /* ───── Attacks ─── */
+    // Squares a bishop/rook on sq attacks when the board holds 'occupancy' (first blocker included)
+    static Bitboard BishopAttacks(uint8_t sq, Bitboard occupancy);
+    static Bitboard RookAttacks(uint8_t sq, Bitboard occupancy);
+
+    // Pieces of both sides attacking sq with the given occupancy: one lookup per piece class,
+    // queens folded into the bishop and rook rays. Mask with a side board for one side's attackers.
+    static Bitboard AttackersTo(const Pieces& pcs, uint8_t sq, Bitboard occupancy);
+
     /* ───── Checks ──── */
+    // True if a piece of the side opposite to s attacks sq
     static bool SquareInDanger(const Pieces& pcs, uint8_t sq, Side s);
 
 private:
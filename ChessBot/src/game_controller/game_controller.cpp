@@ -19,12 +19,6 @@ namespace {
         return PsLegalMaskGen::SquareInDanger(pcs, sq, side);
     }
 
-    inline bool HasNoLegalMoves(const Position& pos, Side side) {
-        MoveList list;
-        LegalMoveGen::Generate(pos, side, list, false);
-        return list.GetSize() == 0;
-    }
-
     // Returns true if the side’s king is in check
     inline bool IsSideInCheck(const Position& pos, Side side) {
         const Bitboard kbb = pos.GetPieces().GetPieceBitboard(side, PieceType::King);
@@ -57,7 +51,7 @@ namespace {
         }
 
         const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
-        if (HasNoLegalMoves(pos, stm)) {
+        if (!LegalMoveGen::HasAnyLegalMove(pos)) {
             if (IsSideInCheck(pos, stm)) {
                 return (stm == Side::White) ? GameResult::BlackWon : GameResult::WhiteWon;
             } else {
@@ -88,6 +82,19 @@ namespace {
         }
     }
 
+    // Textual PV representation: "from-to" square indices separated by spaces
+    inline std::string PvToString(const PvLine& line) {
+        std::ostringstream pv;
+        for (int i = 0; i < line.length; ++i) {
+            const Move m = line.moves[i];
+            pv << static_cast<int>(m.GetFrom()) << "-" << static_cast<int>(m.GetTo());
+            if (i + 1 < line.length) {
+                pv << ' ';
+            }
+        }
+        return pv.str();
+    }
+
     inline bool IsEngineToMove(const Position& pos, const Players& players) {
         const bool white_to_move = pos.IsWhiteToMove();
 
@@ -104,7 +111,13 @@ GameController::GameController(TranspositionTable& table)
     : table_(table) {
 }
 
+GameController::~GameController() {
+    StopPondering_();
+}
+
 void GameController::NewGame(const Players& players, const TimeControl& tc) {
+    StopPondering_();
+
     players_ = players;
     time_control_ = tc;
     result_ = GameResult::Ongoing;
@@ -125,6 +138,8 @@ void GameController::NewGame(const Players& players, const TimeControl& tc) {
 }
 
 void GameController::LoadFEN(const std::string& short_fen, const Players& players, const TimeControl& tc) {
+    StopPondering_();
+
     players_ = players;
     time_control_ = tc;
     result_ = GameResult::Ongoing;
@@ -192,6 +207,19 @@ bool GameController::MakeUserMove(uint8_t from, uint8_t to, uint8_t promo_piece_
         return false;
     }
 
+    // Ponderhit lets the running search go on as the engine's move search; a miss aborts it
+    if (pondering_) {
+        const bool ponder_hit = chosen.GetFrom() == ponder_move_.GetFrom() &&
+                                chosen.GetTo() == ponder_move_.GetTo() &&
+                                chosen.GetFlag() == ponder_move_.GetFlag();
+        if (ponder_hit) {
+            signals_.ponderhit = true;
+        }
+        else {
+            StopPondering_();
+        }
+    }
+
     // Apply move and notify listeners about the move and the new position
     Position::Undo u{};
     position_->ApplyMove(chosen, u);
@@ -205,6 +233,7 @@ bool GameController::MakeUserMove(uint8_t from, uint8_t to, uint8_t promo_piece_
     // Check for terminal state and either finish the game or pass control to the next side
     result_ = DetectResult(*position_);
     if (result_ != GameResult::Ongoing) {
+        StopPondering_();
         state_ = ControllerState::GameOver;
         if (on_game_over_) {
             const char* reason = nullptr;
@@ -270,13 +299,17 @@ void GameController::RequestLegalMask(uint8_t square) {
     on_legal_mask_(square, mask);
 }
 
-// Stores engine search limits to be used on the next search start
+// Stores engine search limits to be used on the next search start; a running ponder search
+// was started with the old limits and is stopped
 void GameController::SetEngineLimits(const EngineLimits& lim) {
+    StopPondering_();
     engine_limits_ = lim;
 }
 
-// Enables or disables the engine for a given side and updates players configuration
+// Enables or disables the engine for a given side and updates players configuration; a running
+// ponder search assumed the old players and is stopped
 void GameController::SetEngineSide(Side side, bool enabled) {
+    StopPondering_();
     if (side == Side::White) {
         players_.white = enabled ? PlayerType::Engine : PlayerType::Human;
     } else {
@@ -284,6 +317,20 @@ void GameController::SetEngineSide(Side side, bool enabled) {
     }
 }
 
+// Resizes the hash table; a running ponder search is stopped first because it probes the table
+TranspositionTable::ResizeResult GameController::ResizeHash(std::size_t size_mb) {
+    StopPondering_();
+    return table_.Resize(size_mb);
+}
+
+int GameController::GetHashfullPermille() const {
+    return table_.HashfullPermille();
+}
+
+TranspositionTable::Counters GameController::GetHashCounters() const {
+    return table_.GetCounters();
+}
+
 // Exports the current position as a short FEN string
 std::string GameController::GetFEN() const {
     if (!position_) {
@@ -355,31 +402,33 @@ void GameController::EnterEngineThinking_() {
 
     if (!engine_) {
         engine_.reset(new SearchEngine(table_));
+        engine_->SetSignals(&signals_);
     }
 
-    SearchLimits limits{};
-    if (engine_limits_.max_depth > 0) {
-        limits.max_depth   = engine_limits_.max_depth;
+    SearchResult res{};
+    if (pondering_) {
+        // Ponderhit: the ponder search already runs on this position with the clock started
+        ponder_thread_.join();
+        pondering_ = false;
+        res = ponder_result_;
     }
-
-    if (engine_limits_.max_nodes > 0) {
-        limits.nodes_limit = engine_limits_.max_nodes;
+    else {
+        // Synchronous search
+        signals_.stop = false;
+        signals_.ponderhit = false;
+        res = engine_->Search(*position_, MakeSearchLimits_());
     }
 
-    // Synchronous search
-    SearchResult res = engine_->Search(*position_, limits);
+    // Emit every reported line, best first (one line unless MultiPV is requested)
+    if (on_search_info_) {
+        for (int i = 0; i < res.line_count; ++i) {
+            on_search_info_(res.depth, res.lines[i].score_cp, PvToString(res.lines[i]));
+        }
+    }
 
     // Emit best move along with a simple textual PV representation
     if (on_best_move_) {
-        std::ostringstream pv;
-        for (int i = 0; i < res.pv.length; ++i) {
-            const Move m = res.pv.moves[i];
-            pv << static_cast<int>(m.GetFrom()) << "-" << static_cast<int>(m.GetTo());
-            if (i + 1 < res.pv.length) {
-                pv << ' ';
-            }
-        }
-        on_best_move_(res.best_move, pv.str());
+        on_best_move_(res.best_move, PvToString(res.pv));
     }
 
     // Apply best move if it looks valid and then evaluate, update position and check for terminal state
@@ -422,11 +471,70 @@ void GameController::EnterEngineThinking_() {
             }
             return;
         }
+
+        // The opponent's thinking time goes to the expected reply. An engine opponent is searched by
+        // this same engine, so engine-vs-engine games never ponder
+        if (engine_limits_.ponder && !IsEngineToMove(*position_, players_)) {
+            StartPondering_(res);
+        }
     }
 
     EnterPlayerTurn_();
 }
 
+SearchLimits GameController::MakeSearchLimits_() const {
+    SearchLimits limits{};
+    if (engine_limits_.max_depth > 0) {
+        limits.max_depth   = engine_limits_.max_depth;
+    }
+
+    if (engine_limits_.max_nodes > 0) {
+        limits.nodes_limit = engine_limits_.max_nodes;
+    }
+
+    if (engine_limits_.max_time_ms > 0) {
+        limits.time_limit_ms = engine_limits_.max_time_ms;
+    }
+
+    limits.multi_pv = engine_limits_.multi_pv;
+    return limits;
+}
+
+// Starts searching the position after the PV reply on the ponder thread
+void GameController::StartPondering_(const SearchResult& last) {
+    if (last.pv.length < 2) {
+        return;
+    }
+
+    ponder_move_ = last.pv.moves[1];
+    ponder_position_.reset(new Position(*position_));
+
+    Position::Undo u{};
+    ponder_position_->ApplyMove(ponder_move_, u);
+
+    signals_.stop = false;
+    signals_.ponderhit = false;
+
+    SearchLimits limits = MakeSearchLimits_();
+    limits.ponder = true;
+
+    pondering_ = true;
+    ponder_thread_ = std::thread([this, limits]() {
+        ponder_result_ = engine_->Search(*ponder_position_, limits);
+    });
+}
+
+// Aborts a running ponder search and waits for the thread; the engine is free afterwards
+void GameController::StopPondering_() {
+    if (!pondering_) {
+        return;
+    }
+
+    signals_.stop = true;
+    ponder_thread_.join();
+    pondering_ = false;
+}
+
 void GameController::ApplyMoveAndNotify_(const Move& m, int eval_cp) {
     Position::Undo u{};
     position_->ApplyMove(m, u);
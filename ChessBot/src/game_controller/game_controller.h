@@ -2,6 +2,10 @@
 * GameController — C++ orchestrator between UI and the chess engine core.
 * It owns game lifecycle, position state, clocks, and exposes callback hooks.
 * The class is UI-agnostic and does not depend on Qt; a thin Qt adapter can wrap it.
+* With pondering enabled the engine searches the expected reply on a background thread while
+* the opponent thinks; a ponderhit turns that search into the engine's timed move search.
+* Only a human opponent is pondered on: both engine sides share one SearchEngine and one table,
+* so in engine-vs-engine play there is no idle opponent time to use and ponder is ignored.
 * This header defines the public API and lightweight data structures for control.
 ************/
 #pragma once
@@ -10,6 +14,7 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <thread>
 
 #include "../board_state/pieces.h"
 #include "../board_state/repetition_history.h"
@@ -33,6 +38,8 @@ struct EngineLimits {
     int max_depth = 0;
     int max_time_ms = 1'000;
     int max_nodes = 0;
+    int multi_pv = 1; // analysis: number of best lines reported through OnSearchInfo
+    bool ponder = false; // search the expected reply while a human opponent thinks (ignored engine-vs-engine)
 };
 
 enum class PlayerType {
@@ -67,6 +74,7 @@ enum class ControllerState : uint8_t {
 class GameController {
 public:
     explicit GameController(TranspositionTable& tt);
+    ~GameController();
 
     void NewGame(const Players& players, const TimeControl& tc);
     void LoadFEN(const std::string& short_fen, const Players& players, const TimeControl& tc);
@@ -77,6 +85,11 @@ public:
     void SetEngineLimits(const EngineLimits& lim);
     void SetEngineSide(Side side, bool enabled);
 
+    // Hash table shared with the engine: runtime size and live statistics
+    TranspositionTable::ResizeResult ResizeHash(std::size_t size_mb);
+    int GetHashfullPermille() const;
+    TranspositionTable::Counters GetHashCounters() const;
+
     std::string GetFEN() const;
     GameResult GetResult() const;
     int GetPiece(int square) const;
@@ -101,6 +114,10 @@ private:
     void ApplyMoveAndNotify_(const Move& m, int eval_cp);
     void EmitPosition_() const;
 
+    SearchLimits MakeSearchLimits_() const;
+    void StartPondering_(const SearchResult& last);
+    void StopPondering_();
+
 private:
     TranspositionTable& table_;
 
@@ -121,4 +138,14 @@ private:
     OnBestMove on_best_move_{};
     OnGameOver on_game_over_{};
     OnLegalMask on_legal_mask_{};
+
+    // Pondering: the engine is owned by the ponder thread while pondering_ is set
+    SearchSignals signals_{};
+    std::thread ponder_thread_{};
+    std::unique_ptr<Position> ponder_position_;
+    Move ponder_move_{};
+    SearchResult ponder_result_{};
+    bool pondering_ = false;
+
+    friend class GameControllerTest;
 };
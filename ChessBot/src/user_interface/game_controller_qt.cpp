@@ -140,6 +140,23 @@ void GameControllerQt::SetEngineDepthLimit(int max_depth) {
     controller_->SetEngineLimits(lim);
 }
 
+bool GameControllerQt::SetHashSize(int size_mb) {
+    if (controller_ == nullptr || size_mb <= 0) {
+        return false;
+    }
+
+    // False also when a 1 MB fallback table had to be used instead of the requested size
+    return controller_->ResizeHash(static_cast<std::size_t>(size_mb)) == TranspositionTable::ResizeResult::Resized;
+}
+
+int GameControllerQt::HashfullPermille() const {
+    if (controller_ == nullptr) {
+        return 0;
+    }
+
+    return controller_->GetHashfullPermille();
+}
+
 void GameControllerQt::EmitSnapshotFromPosition() {
     const QByteArray pieces = BuildPiecesArrayFromEngine();
     const bool white_to_move = true; // Obtain from Position (move_counter_ rule)
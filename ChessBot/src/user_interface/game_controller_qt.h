@@ -25,6 +25,8 @@ public:
     Q_INVOKABLE bool MakeUserMove(int from, int to, int promo_piece_type = 0);
     Q_INVOKABLE void RequestLegalMask(int square);
     Q_INVOKABLE void SetEngineDepthLimit(int max_depth);
+    Q_INVOKABLE bool SetHashSize(int size_mb);
+    Q_INVOKABLE int HashfullPermille() const;
 
 signals:
     // UI updates (emitted by adapter on controller events)
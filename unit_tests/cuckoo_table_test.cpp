@@ -0,0 +1,101 @@
+#include "cuckoo_table_test.h"
+
+#include "../ChessBot/src/engine_core/board_state/cuckoo_table.h"
+#include "../ChessBot/src/engine_core/board_state/position.h"
+
+namespace {
+    Move Quiet(uint8_t from, uint8_t to, PieceType type, Side side) {
+        return Move(from, to, static_cast<uint8_t>(type), static_cast<uint8_t>(side),
+                    Move::None, Move::None, Move::Flag::Default);
+    }
+} // namespace
+
+void CuckooTableTest::Table_ShouldStoreAllReversibleMoves() {
+    // Knight, bishop, rook, queen and king moves of both colours on an empty board, known at compile time
+    static_assert(CuckooTable::GetEntryCount() == 3668u);
+    QCOMPARE(CuckooTable::GetEntryCount(), 3668u);
+
+    // Every move is found by its key delta, in either direction
+    const uint64_t delta = ZobristHash::PieceKey(1, PieceType::Knight, 0) ^
+                           ZobristHash::PieceKey(18, PieceType::Knight, 0) ^
+                           ZobristHash::BlackToMoveKey();
+    const CuckooTable::Entry* entry = CuckooTable::Find(delta);
+    QVERIFY(entry != nullptr);
+    QCOMPARE(static_cast<int>(entry->from), 1);
+    QCOMPARE(static_cast<int>(entry->to), 18);
+
+    // A pawn push is not reversible
+    QVERIFY(CuckooTable::Find(ZobristHash::PieceKey(8, PieceType::Pawn, 0) ^
+                              ZobristHash::PieceKey(16, PieceType::Pawn, 0) ^
+                              ZobristHash::BlackToMoveKey()) == nullptr);
+}
+
+void CuckooTableTest::KnightShuffle_ShouldAllowUpcomingRepetition() {
+    Position pos("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE,
+                 true, true, true, true, 0);
+
+    const Move moves[] = {
+        Quiet(6, 21, PieceType::Knight, Side::White),   // Ng1-f3
+        Quiet(62, 45, PieceType::Knight, Side::Black),  // Ng8-f6
+        Quiet(21, 6, PieceType::Knight, Side::White),   // Nf3-g1
+    };
+
+    Position::Undo u;
+    for (uint32_t i = 0; i < 3; ++i) {
+        QVERIFY(!pos.HasUpcomingRepetition(i));
+        pos.ApplyMove(moves[i], u);
+    }
+
+    // Black to move: Nf6-g8 returns to the start position
+    QVERIFY(pos.HasUpcomingRepetition(3));
+}
+
+void CuckooTableTest::PreRootCycle_ShouldNeedEarlierRepetition() {
+    Position pos("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE,
+                 true, true, true, true, 0);
+
+    const Move shuffle[] = {
+        Quiet(6, 21, PieceType::Knight, Side::White),   // Ng1-f3
+        Quiet(62, 45, PieceType::Knight, Side::Black),  // Ng8-f6
+        Quiet(21, 6, PieceType::Knight, Side::White),   // Nf3-g1
+        Quiet(45, 62, PieceType::Knight, Side::Black),  // Nf6-g8
+    };
+
+    // Root after Ng1-f3: Nf6-g8 would only repeat the start position once, from before the root
+    Position::Undo u;
+    for (int i = 0; i < 3; ++i) {
+        pos.ApplyMove(shuffle[i], u);
+    }
+    QVERIFY(!pos.HasUpcomingRepetition(2));
+
+    // After another shuffle the start position occurred twice: returning to it is a draw
+    pos.ApplyMove(shuffle[3], u);
+    for (int i = 0; i < 3; ++i) {
+        pos.ApplyMove(shuffle[i], u);
+    }
+    QVERIFY(pos.HasUpcomingRepetition(2));
+}
+
+void CuckooTableTest::BlockedSlider_ShouldNotAllowUpcomingRepetition() {
+    // Black to move; the white queen walks a1-b2-a3 while the black king makes a triangle.
+    // Qa3-a1 would repeat the start position unless a2 is occupied.
+    for (bool pawn_on_a2 : { false, true }) {
+        Position pos(pawn_on_a2 ? "4k3/8/8/8/8/8/P7/Q3K3" : "4k3/8/8/8/8/8/8/Q3K3",
+                     Position::NONE, false, false, false, false, 1);
+
+        const Move moves[] = {
+            Quiet(60, 59, PieceType::King, Side::Black),   // Ke8-d8
+            Quiet(0, 9, PieceType::Queen, Side::White),    // Qa1-b2
+            Quiet(59, 51, PieceType::King, Side::Black),   // Kd8-d7
+            Quiet(9, 16, PieceType::Queen, Side::White),   // Qb2-a3
+            Quiet(51, 60, PieceType::King, Side::Black),   // Kd7-e8
+        };
+
+        Position::Undo u;
+        for (const Move& m : moves) {
+            pos.ApplyMove(m, u);
+        }
+
+        QCOMPARE(pos.HasUpcomingRepetition(5), !pawn_on_a2);
+    }
+}
@@ -0,0 +1,18 @@
+/************
+* CuckooTable tests
+* Checks: number of reversible moves (compile-time table) and lookup by key delta;
+* upcoming repetition with free and blocked paths and through positions before the root.
+************/
+#pragma once
+
+#include <QObject>
+#include <QtTest>
+
+class CuckooTableTest : public QObject {
+    Q_OBJECT
+private slots:
+    void Table_ShouldStoreAllReversibleMoves();
+    void KnightShuffle_ShouldAllowUpcomingRepetition();
+    void BlockedSlider_ShouldNotAllowUpcomingRepetition();
+    void PreRootCycle_ShouldNeedEarlierRepetition();
+};
@@ -0,0 +1,56 @@
+#include "game_controller_test.h"
+
+#include "../ChessBot/src/game_controller/game_controller.h"
+#include "../ChessBot/src/engine_core/ai_logic/transposition_table.h"
+
+namespace {
+    // Human White against the engine with pondering; after 1. e4 the engine answers and ponders
+    void StartPonderingGame(GameController& gc) {
+        EngineLimits limits;
+        limits.max_time_ms = 50;
+        limits.ponder = true;
+        gc.SetEngineLimits(limits);
+
+        Players players;
+        players.white = PlayerType::Human;
+        players.black = PlayerType::Engine;
+        gc.NewGame(players, TimeControl{});
+
+        gc.MakeUserMove(12, 28); // e2-e4
+    }
+} // namespace
+
+void GameControllerTest::SetEngineSide_ShouldStopPondering() {
+    TranspositionTable tt(8);
+    GameController gc(tt);
+    StartPonderingGame(gc);
+    QVERIFY2(gc.pondering_, "The engine must ponder while the human thinks");
+
+    const Move expected = gc.ponder_move_;
+
+    // Black becomes human in the middle of the ponder search
+    gc.SetEngineSide(Side::Black, false);
+    QVERIFY(!gc.pondering_);
+    QVERIFY(!gc.ponder_thread_.joinable());
+
+    // The expected reply is no ponderhit any more: nobody is left to search
+    QVERIFY(gc.MakeUserMove(expected.GetFrom(), expected.GetTo()));
+    QVERIFY(!gc.pondering_);
+    QVERIFY(!gc.ponder_thread_.joinable());
+    QVERIFY(!gc.signals_.ponderhit.load());
+    QVERIFY(gc.state_ == ControllerState::PlayerTurn);
+}
+
+void GameControllerTest::SetEngineLimits_ShouldStopPondering() {
+    TranspositionTable tt(8);
+    GameController gc(tt);
+    StartPonderingGame(gc);
+    QVERIFY2(gc.pondering_, "The engine must ponder while the human thinks");
+
+    // New limits: the ponder search started with the old ones is stopped
+    EngineLimits limits;
+    limits.max_time_ms = 20;
+    gc.SetEngineLimits(limits);
+    QVERIFY(!gc.pondering_);
+    QVERIFY(!gc.ponder_thread_.joinable());
+}
@@ -0,0 +1,15 @@
+/************
+* GameController tests
+* Checks: a running ponder search is stopped when the engine side or the engine limits change.
+************/
+#pragma once
+
+#include <QObject>
+#include <QtTest>
+
+class GameControllerTest : public QObject {
+    Q_OBJECT
+private slots:
+    void SetEngineSide_ShouldStopPondering();
+    void SetEngineLimits_ShouldStopPondering();
+};
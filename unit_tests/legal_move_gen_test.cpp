@@ -1,5 +1,10 @@
 #include "legal_move_gen_test.h"
 
+#include <QSet>
+
+#include <algorithm>
+#include <vector>
+
 #include "../ChessBot/src/engine_core/board_state/position.h"
 #include "../ChessBot/src/engine_core/board_state/move.h"
 #include "../ChessBot/src/engine_core/board_state/pieces.h"
@@ -165,6 +170,205 @@ void LegalMoveGenTest::Perft_Endgame() {
     QCOMPARE(Perft2(pos, Side::White), 191ull);
 }
 
+void LegalMoveGenTest::QuietChecksShouldMatchBruteForce() {
+    struct Case { const char* fen; Side stm; };
+    const Case cases[] = {
+        // Kiwipete: только прямые шахи
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Side::White},
+        // вскрытые шахи: конь и пешка перекрывают ладью, слон перекрывает ферзя
+        {"4k3/8/8/4N3/8/3B4/4R3/Q3K3", Side::White},
+        {"3k4/8/8/3P4/8/8/3R4/4K3", Side::White},
+        {"4k3/4r3/8/8/4n3/8/8/3K4", Side::Black}
+    };
+
+    for (const auto& c : cases) {
+        Position pos(c.fen, Position::NONE, false,false,false,false,
+                     c.stm == Side::White ? 0 : 1);
+        const Side enemy = Opp(c.stm);
+
+        // эталон: все легальные тихие ходы, после которых вражеский король под боем
+        QSet<QString> expected;
+        MoveList all; GenAll(pos, c.stm, all);
+        for (uint32_t i = 0; i < all.GetSize(); ++i) {
+            const Move m = all[i];
+            const bool quiet = m.GetDefenderType() == Move::None &&
+                               (m.GetFlag() == Move::Flag::Default || m.GetFlag() == Move::Flag::PawnLongMove);
+            if (!quiet) {
+                continue;
+            }
+            Position::Undo u{}; pos.ApplyMove(m, u);
+            const uint8_t ksq = BOp::BitScanForward(pos.GetPieces().GetPieceBitboard(enemy, PieceType::King));
+            if (PsLegalMaskGen::SquareInDanger(pos.GetPieces(), ksq, enemy)) {
+                expected.insert(MoveStr(m));
+            }
+            pos.UndoMove(m, u);
+        }
+
+        QSet<QString> got;
+        MoveList checks; LegalMoveGen::GenerateQuietChecks(pos, c.stm, checks);
+        for (uint32_t i = 0; i < checks.GetSize(); ++i) {
+            QVERIFY2(!got.contains(MoveStr(checks[i])), qPrintable(MoveStr(checks[i])));
+            got.insert(MoveStr(checks[i]));
+        }
+
+        QCOMPARE(got, expected);
+    }
+}
+
+namespace {
+    // from | to | flag: moves of one position compared as sets
+    std::vector<int> MoveKeys(const MoveList& ml) {
+        std::vector<int> keys;
+        for (uint32_t i = 0; i < ml.GetSize(); ++i) {
+            keys.push_back(ml[i].GetFrom() | (ml[i].GetTo() << 6) | (static_cast<int>(ml[i].GetFlag()) << 12));
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    // Compares every generation type with Generate(..., only_captures) in pos and its subtree;
+    // returns the number of positions in check that were visited
+    int CheckGenTypes(Position& pos, int depth) {
+        const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
+        const uint8_t ksq = BOp::BitScanForward(pos.GetPieces().GetPieceBitboard(stm, PieceType::King));
+        const bool in_check = PsLegalMaskGen::SquareInDanger(pos.GetPieces(), ksq, stm);
+
+        MoveList all, captures, quiets, evasions, checks, checks_appended;
+        LegalMoveGen::Generate(pos, stm, all, /*only_captures=*/false);
+        LegalMoveGen::Generate(pos, stm, GenType::Captures, captures);
+        LegalMoveGen::Generate(pos, stm, GenType::Quiets, quiets);
+        LegalMoveGen::Generate(pos, stm, GenType::Evasions, evasions);
+        LegalMoveGen::Generate(pos, stm, GenType::QuietChecks, checks);
+        LegalMoveGen::GenerateQuietChecks(pos, stm, checks_appended);
+
+        MoveList only_captures;
+        LegalMoveGen::Generate(pos, stm, only_captures, /*only_captures=*/true);
+        if (MoveKeys(captures) != MoveKeys(only_captures)) {
+            return -1;
+        }
+
+        std::vector<int> split = MoveKeys(captures);
+        const std::vector<int> quiet_keys = MoveKeys(quiets);
+        split.insert(split.end(), quiet_keys.begin(), quiet_keys.end());
+        std::sort(split.begin(), split.end());
+        if (split != MoveKeys(all) || MoveKeys(evasions) != MoveKeys(all) ||
+            MoveKeys(checks) != MoveKeys(checks_appended)) {
+            return -1;
+        }
+
+        // Evasions keep the order of All, so the search sees identical move lists
+        if (in_check) {
+            for (uint32_t i = 0; i < all.GetSize(); ++i) {
+                if (all[i].GetFrom() != evasions[i].GetFrom() || all[i].GetTo() != evasions[i].GetTo() ||
+                    all[i].GetFlag() != evasions[i].GetFlag()) {
+                    return -1;
+                }
+            }
+        }
+
+        int checked = in_check ? 1 : 0;
+        if (depth > 1) {
+            for (uint32_t i = 0; i < all.GetSize(); ++i) {
+                Position::Undo u{}; pos.ApplyMove(all[i], u);
+                const int sub = CheckGenTypes(pos, depth - 1);
+                pos.UndoMove(all[i], u);
+                if (sub < 0) {
+                    return -1;
+                }
+                checked += sub;
+            }
+        }
+        return checked;
+    }
+} // namespace
+
+void LegalMoveGenTest::GenTypesShouldPartitionAllMoves() {
+    struct Case { const char* fen; uint8_t ep; bool wl, ws, bl, bs; uint16_t move_counter; };
+    const Case cases[] = {
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Position::NONE, true, true, true, true, 0},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R", Position::NONE, true, true, false, false, 0},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8", Position::NONE, false, false, false, false, 0},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1", Position::NONE, false, false, true, true, 0},
+        // двойной шах и шах пешкой, снимаемый взятием на проходе
+        {"4k3/8/8/8/8/5n2/8/r3K3", Position::NONE, false, false, false, false, 0},
+        {"8/8/8/2k5/3Pp3/8/8/4K3", 19, false, false, false, false, 1},
+    };
+
+    int in_check = 0;
+    for (const auto& c : cases) {
+        Position pos(c.fen, c.ep, c.wl, c.ws, c.bl, c.bs, c.move_counter);
+        const int checked = CheckGenTypes(pos, 3);
+        QVERIFY2(checked >= 0, c.fen);
+        in_check += checked;
+    }
+    QVERIFY(in_check > 0);
+
+    // Template entry point without the dispatcher
+    Position start("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE, true, true, true, true, 0);
+    MoveList quiets;
+    LegalMoveGen::Generate<Side::White, GenType::Quiets>(start, quiets);
+    QCOMPARE(static_cast<int>(quiets.GetSize()), 20);
+    MoveList captures;
+    LegalMoveGen::Generate<Side::White, GenType::Captures>(start, captures);
+    QCOMPARE(static_cast<int>(captures.GetSize()), 0);
+}
+
+// Compares HasAnyLegalMove with a non-empty Generate in pos and its subtree;
+// returns the number of positions without legal moves, or -1 on a mismatch
+static int CheckHasAnyLegalMove(Position& pos, int depth) {
+    const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
+    MoveList all;
+    LegalMoveGen::Generate(pos, stm, all, /*only_captures=*/false);
+
+    if (LegalMoveGen::HasAnyLegalMove(pos) != (all.GetSize() != 0)) {
+        return -1;
+    }
+
+    int terminal = (all.GetSize() == 0) ? 1 : 0;
+    if (depth > 1) {
+        for (uint32_t i = 0; i < all.GetSize(); ++i) {
+            Position::Undo u{}; pos.ApplyMove(all[i], u);
+            const int sub = CheckHasAnyLegalMove(pos, depth - 1);
+            pos.UndoMove(all[i], u);
+            if (sub < 0) {
+                return -1;
+            }
+            terminal += sub;
+        }
+    }
+    return terminal;
+}
+
+void LegalMoveGenTest::HasAnyLegalMoveShouldAgreeWithGenerate() {
+    struct Case { const char* fen; uint8_t ep; bool wl, ws, bl, bs; uint16_t move_counter; int depth; };
+    const Case cases[] = {
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Position::NONE, true, true, true, true, 0, 3},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R", Position::NONE, true, true, false, false, 0, 3},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8", Position::NONE, false, false, false, false, 0, 4},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1", Position::NONE, false, false, true, true, 0, 3},
+        // мат, пат, и шах пешкой, от которого спасает только взятие на проходе
+        {"6k1/5ppp/8/8/8/8/5PPP/3R2K1", Position::NONE, false, false, false, false, 0, 2},
+        {"7k/5Q2/6K1/8/8/8/8/8", Position::NONE, false, false, false, false, 1, 1},
+        {"8/8/2Q5/k7/1Pp5/1K6/8/8", 17, false, false, false, false, 1, 1},
+    };
+
+    int terminal = 0;
+    for (const auto& c : cases) {
+        Position pos(c.fen, c.ep, c.wl, c.ws, c.bl, c.bs, c.move_counter);
+        const int found = CheckHasAnyLegalMove(pos, c.depth);
+        QVERIFY2(found >= 0, c.fen);
+        terminal += found;
+    }
+    QVERIFY(terminal > 0);
+
+    Position stalemate("7k/5Q2/6K1/8/8/8/8/8", Position::NONE, false, false, false, false, 1);
+    QVERIFY(!LegalMoveGen::HasAnyLegalMove(stalemate));
+    QVERIFY(!LegalMoveGen::HasAnyLegalMove<Side::Black>(stalemate));
+
+    Position ep_only("8/8/2Q5/k7/1Pp5/1K6/8/8", 17, false, false, false, false, 1);
+    QVERIFY(LegalMoveGen::HasAnyLegalMove(ep_only));
+}
+
 // // Временный отладочный тест
 // void LegalMoveGenTest::Perft_StartPos_Divide4_Print() {
 //     Position pos("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R",
@@ -20,6 +20,15 @@ private slots:
     void Perft_EnPassant();
     void Perft_Endgame();
 
+    // Тихие шахи: прямые и вскрытые
+    void QuietChecksShouldMatchBruteForce();
+
+    // Шаблонная генерация по типам: Captures + Quiets = All, Evasions = All под шахом
+    void GenTypesShouldPartitionAllMoves();
+
+    // Быстрая проверка наличия хода: совпадает с пустотой полного списка
+    void HasAnyLegalMoveShouldAgreeWithGenerate();
+
     //void Perft_StartPos_Divide4_Print();
     void Debug_Divide_Position2_d4();
 };
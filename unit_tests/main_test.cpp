@@ -11,14 +11,20 @@
 #include "transposition_table_test.h"
 #include "move_ordering_test.h"
 #include "see_test.h"
+#include "cuckoo_table_test.h"
+#include "search_history_test.h"
+#include "game_controller_test.h"
 
 #include "legal_move_gen_tester.h"
+#include "micro_benchmarks.h"
 
 int main(int argc, char** argv) {
     int status = 0;
 
     {
         //LegalMoveGenTester::RunTests();
+        //MicroBenchmarks::RunAttackersTo();
+        //MicroBenchmarks::RunHasAnyLegalMove();
     }
 
     {
@@ -81,5 +87,20 @@ int main(int argc, char** argv) {
         status |= QTest::qExec(&t, argc, argv);
     }
 
+    {
+        CuckooTableTest t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+
+    {
+        SearchHistoryTest t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+
+    {
+        GameControllerTest t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+
     return status;
 }
@@ -3,6 +3,8 @@
 #include "../ChessBot/src/engine_core/board_state/pieces.h"
 #include "../ChessBot/src/engine_core/board_state/position.h"
 #include "../ChessBot/src/engine_core/move_generation/pawn_attack_masks.h"
+#include "../ChessBot/src/engine_core/move_generation/knight_masks.h"
+#include "../ChessBot/src/engine_core/move_generation/king_masks.h"
 #include "../ChessBot/src/engine_core/move_generation/ps_legal_move_mask_gen.h"
 
 /*──────────────────── Pawn attack LUT ───────────────────*/
@@ -126,3 +128,58 @@ void MaskGenTest::SquareInDangerShouldReturnFalseWhenSafe() {
     //Pieces pcs("rnb1kbnr/pppp1ppp/4pq2/8/8/1P2P3/P1PP1PPP/RNBQKBNR");
     QVERIFY(!PsLegalMaskGen::SquareInDanger(pcs, 2, Side::White));
 }
+
+/* 11. attackers_to equals a piece-by-piece scan (sliders walked square by square) */
+static bool AttacksByWalking(const Pieces& pcs, uint8_t from, uint8_t to, bool diagonal) {
+    const int dr = (to >> 3) - (from >> 3);
+    const int dc = (to & 7) - (from & 7);
+    if (diagonal ? (dr == 0 || dr * dr != dc * dc) : (dr != 0 && dc != 0) || (dr == 0 && dc == 0)) {
+        return false;
+    }
+    const int step = (dr > 0 ? 8 : dr < 0 ? -8 : 0) + (dc > 0 ? 1 : dc < 0 ? -1 : 0);
+    for (int sq = from + step; sq != to; sq += step) {
+        if (BOp::GetBit(pcs.GetAllBitboard(), sq)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MaskGenTest::AttackersToShouldMatchPieceByPieceScan() {
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1",
+    };
+
+    for (const char* fen : fens) {
+        Pieces pcs(fen);
+        for (uint8_t target = 0; target < 64; ++target) {
+            Bitboard expected = 0;
+            for (uint8_t from = 0; from < 64; ++from) {
+                auto [side, type] = pcs.GetPiece(from);
+                bool attacks = false;
+                switch (type) {
+                case PieceType::Pawn:   attacks = BOp::GetBit(PawnMasks::kAttack[static_cast<int>(side)][from], target); break;
+                case PieceType::Knight: attacks = BOp::GetBit(KnightMasks::kMasks[from], target); break;
+                case PieceType::King:   attacks = BOp::GetBit(KingMasks::kMasks[from], target); break;
+                case PieceType::Bishop: attacks = AttacksByWalking(pcs, from, target, true); break;
+                case PieceType::Rook:   attacks = AttacksByWalking(pcs, from, target, false); break;
+                case PieceType::Queen:  attacks = AttacksByWalking(pcs, from, target, true)
+                                                || AttacksByWalking(pcs, from, target, false); break;
+                default: break;
+                }
+                if (attacks) {
+                    expected = BOp::Set_1(expected, from);
+                }
+            }
+
+            QCOMPARE(PsLegalMaskGen::AttackersTo(pcs, target, pcs.GetAllBitboard()), expected);
+            for (Side s : {Side::White, Side::Black}) {
+                const bool danger = (expected & pcs.GetSideBoard(Pieces::Inverse(s))) != 0;
+                QCOMPARE(PsLegalMaskGen::SquareInDanger(pcs, target, s), danger);
+            }
+        }
+    }
+}
@@ -19,4 +19,5 @@ private slots:
     void PawnCaptureMaskAllAttacksVsLegal();
     void BishopMaskOnEmptyBoardEqualsTable();
     void SquareInDangerShouldReturnFalseWhenSafe();
+    void AttackersToShouldMatchPieceByPieceScan();
 };
@@ -0,0 +1,119 @@
+#include "micro_benchmarks.h"
+
+#include <random>
+
+#include "../ChessBot/src/engine_core/move_generation/ps_legal_move_mask_gen.h"
+#include "../ChessBot/src/engine_core/move_generation/legal_move_gen.h"
+#include "../ChessBot/src/engine_core/move_generation/move_list.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kRounds = 20'000;
+
+void Report(const char* name, Clock::time_point start, uint64_t calls, uint64_t checksum) {
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    std::cout << std::setw(24) << std::left << name << std::right
+              << std::setw(8) << std::fixed << std::setprecision(2) << ns / double(calls) << " ns/call"
+              << "  (checksum " << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+std::array<Pieces, 6> MicroBenchmarks::Corpus() {
+    return {
+        Pieces("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"),
+        Pieces("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R"),
+        Pieces("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R"),
+        Pieces("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1"),
+        Pieces("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8"),
+        Pieces("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1"),
+    };
+}
+
+// AttackersTo and SquareInDanger over every square of the corpus positions
+void MicroBenchmarks::RunAttackersTo() {
+    const auto corpus = Corpus();
+    const uint64_t calls = uint64_t(kRounds) * corpus.size() * 64;
+
+    {
+        uint64_t checksum = 0;
+        const auto start = Clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            for (const Pieces& pcs : corpus) {
+                const Bitboard occ = pcs.GetAllBitboard();
+                for (uint8_t sq = 0; sq < 64; ++sq) {
+                    checksum += PsLegalMaskGen::AttackersTo(pcs, sq, occ);
+                }
+            }
+        }
+        Report("AttackersTo", start, calls, checksum);
+    }
+
+    {
+        uint64_t checksum = 0;
+        const auto start = Clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            for (const Pieces& pcs : corpus) {
+                for (uint8_t sq = 0; sq < 64; ++sq) {
+                    checksum += PsLegalMaskGen::SquareInDanger(pcs, sq, Side::White);
+                }
+            }
+        }
+        Report("SquareInDanger", start, calls, checksum);
+    }
+}
+
+std::vector<Position> MicroBenchmarks::RandomPositions(int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<Position> positions;
+    positions.reserve(count);
+
+    const Position start("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE, true, true, true, true, 0);
+    Position pos = start;
+    while (static_cast<int>(positions.size()) < count) {
+        const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
+        MoveList moves;
+        LegalMoveGen::Generate(pos, stm, moves);
+
+        positions.push_back(pos);
+        if (moves.GetSize() == 0 || pos.IsFiftyMoveRuleDraw()) {
+            pos = start; // game over: start the next playout
+            continue;
+        }
+        pos.ApplyMove(moves[rng() % moves.GetSize()]);
+    }
+    return positions;
+}
+
+// HasAnyLegalMove against a full Generate and an emptiness test, on random playout positions
+void MicroBenchmarks::RunHasAnyLegalMove() {
+    const std::vector<Position> corpus = RandomPositions(10'000, 20251018u);
+    constexpr int kPasses = 100;
+    const uint64_t calls = uint64_t(kPasses) * corpus.size();
+
+    {
+        uint64_t checksum = 0;
+        const auto start = Clock::now();
+        for (int pass = 0; pass < kPasses; ++pass) {
+            for (const Position& pos : corpus) {
+                MoveList moves;
+                LegalMoveGen::Generate(pos, pos.IsWhiteToMove() ? Side::White : Side::Black, moves);
+                checksum += moves.GetSize() != 0;
+            }
+        }
+        Report("Generate != empty", start, calls, checksum);
+    }
+
+    {
+        uint64_t checksum = 0;
+        const auto start = Clock::now();
+        for (int pass = 0; pass < kPasses; ++pass) {
+            for (const Position& pos : corpus) {
+                checksum += LegalMoveGen::HasAnyLegalMove(pos);
+            }
+        }
+        Report("HasAnyLegalMove", start, calls, checksum);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../ChessBot/src/engine_core/board_state/pieces.h"
+#include "../ChessBot/src/engine_core/board_state/position.h"
+
+// Timing loops for single engine primitives; run by hand from main_test.cpp and read the ns/call.
+class MicroBenchmarks
+{
+public:
+    static void RunAttackersTo();
+    static void RunHasAnyLegalMove();
+
+private:
+    static std::array<Pieces, 6> Corpus();
+
+    // Positions reached by random playouts from the start position (fixed seed)
+    static std::vector<Position> RandomPositions(int count, uint32_t seed);
+};
@@ -1,5 +1,7 @@
 #include "move_ordering_test.h"
 
+#include <memory>
+
 #include "../ChessBot/src/engine_core/board_state/pieces.h"
 #include "../ChessBot/src/engine_core/board_state/move.h"
 #include "../ChessBot/src/engine_core/ai_logic/move_ordering.h"
@@ -25,12 +27,13 @@ void MoveOrderingTest::TtMove_ShouldOutscoreOthers() {
            Move::None, static_cast<uint8_t>(Side::Black),
            Move::Flag::Default);
 
-    static int hist[2][64][64]{};
+    auto hist = std::make_unique<SearchHistory>();
+    hist->Clear();
     MoveOrdering::Context ctx{};
     ctx.tt_move = tt;
     ctx.cutoff1 = 0;
     ctx.cutoff2 = 0;
-    ctx.history = &hist;
+    ctx.history = hist.get();
     ctx.side_to_move = Side::White;
 
     const int s_tt = MoveOrdering::Score(tt, pcs, ctx);
@@ -65,3 +68,60 @@ void MoveOrderingTest::Capture_ShouldOutscoreQuiet() {
 
     QVERIFY2(s_cap > s_quiet, "Capture should score higher than a simple move");
 }
+
+void MoveOrderingTest::Countermove_ShouldOutscoreHistory() {
+    Pieces pcs = SimpleMaterial();
+
+    Move counter(1, 16, static_cast<uint8_t>(PieceType::Knight),
+                 static_cast<uint8_t>(Side::White),
+                 Move::None, Move::None, Move::Flag::Default);
+
+    Move favoured(1, 11, static_cast<uint8_t>(PieceType::Knight),
+                  static_cast<uint8_t>(Side::White),
+                  Move::None, Move::None, Move::Flag::Default);
+
+    auto hist = std::make_unique<SearchHistory>();
+    hist->Clear();
+    for (int i = 0; i < 50; ++i) {
+        hist->UpdateButterfly(Side::White, favoured, SearchHistory::Bonus(10));
+    }
+
+    MoveOrdering::Context ctx{};
+    ctx.tt_move = Move{};
+    ctx.history = hist.get();
+    ctx.countermove = static_cast<uint16_t>(counter.GetFrom() | (counter.GetTo() << 8));
+    ctx.side_to_move = Side::White;
+
+    QVERIFY(MoveOrdering::Score(counter, pcs, ctx) > MoveOrdering::Score(favoured, pcs, ctx));
+
+    // Without the countermove hint the history-favoured move comes first
+    ctx.countermove = 0;
+    QVERIFY(MoveOrdering::Score(favoured, pcs, ctx) > MoveOrdering::Score(counter, pcs, ctx));
+}
+
+void MoveOrderingTest::ContinuationHistory_ShouldRaiseQuietScore() {
+    Pieces pcs = SimpleMaterial();
+
+    Move previous(50, 42, static_cast<uint8_t>(PieceType::Pawn),
+                  static_cast<uint8_t>(Side::Black),
+                  Move::None, Move::None, Move::Flag::Default);
+
+    Move quiet(1, 11, static_cast<uint8_t>(PieceType::Knight),
+               static_cast<uint8_t>(Side::White),
+               Move::None, Move::None, Move::Flag::Default);
+
+    auto hist = std::make_unique<SearchHistory>();
+    hist->Clear();
+
+    MoveOrdering::Context ctx{};
+    ctx.tt_move = Move{};
+    ctx.history = hist.get();
+    ctx.continuation[0] = hist->GetContinuation(previous);
+    ctx.side_to_move = Side::White;
+
+    const int before = MoveOrdering::Score(quiet, pcs, ctx);
+    SearchHistory::UpdateContinuation(hist->GetContinuation(previous), quiet, SearchHistory::Bonus(6));
+    const int after = MoveOrdering::Score(quiet, pcs, ctx);
+
+    QVERIFY(after > before);
+}
@@ -1,6 +1,6 @@
 /************
 * MoveOrdering tests
-* Checks: TT move top priority; captures outrank quiet moves.
+* Checks: TT move top priority; captures outrank quiet moves; countermove and continuation history.
 ************/
 #pragma once
 
@@ -12,4 +12,6 @@ class MoveOrderingTest : public QObject {
 private slots:
     void TtMove_ShouldOutscoreOthers();
     void Capture_ShouldOutscoreQuiet();
+    void Countermove_ShouldOutscoreHistory();
+    void ContinuationHistory_ShouldRaiseQuietScore();
 };
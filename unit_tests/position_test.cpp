@@ -1,5 +1,34 @@
 #include "position_test.h"
 #include "../ChessBot/src/engine_core/board_state/position.h"
+#include "../ChessBot/src/engine_core/move_generation/legal_move_gen.h"
+#include "../ChessBot/src/engine_core/move_generation/move_list.h"
+
+namespace {
+
+// Walks every move down to depth plies and compares KeyAfter with the key ApplyMove produces;
+// returns the number of mismatches
+uint64_t CountKeyAfterMismatches(Position& pos, int depth) {
+    const Side stm = pos.IsWhiteToMove() ? Side::White : Side::Black;
+    MoveList moves;
+    LegalMoveGen::Generate(pos, stm, moves);
+
+    uint64_t mismatches = 0;
+    for (uint32_t i = 0; i < moves.GetSize(); ++i) {
+        const uint64_t predicted = pos.KeyAfter(moves[i]);
+        Position::Undo u{};
+        pos.ApplyMove(moves[i], u);
+        if (pos.GetZobristKey() != predicted) {
+            ++mismatches;
+        }
+        if (depth > 1) {
+            mismatches += CountKeyAfterMismatches(pos, depth - 1);
+        }
+        pos.UndoMove(moves[i], u);
+    }
+    return mismatches;
+}
+
+} // namespace
 
 // === Initialization & Basic Mechanics ===
 
@@ -253,18 +282,141 @@ void PositionTest::MoveShouldHandleCastlingCorrectly() {
 // === Repetition & Hash ===
 
 void PositionTest::ShouldDetectThreefoldRepetition() {
-    // Empty board, hash repeated 3 times manually
-    Position p("8/8/8/8/8/8/8/8", Position::NONE, false, false, false, false, 0);
+    // Kings shuffle e1-f1, e8-f8, f1-e1, f8-e8 twice: the start position occurs three times
+    Position p("4k3/8/8/8/8/8/8/4K3", Position::NONE, false, false, false, false, 0);
+
+    const uint8_t king  = static_cast<uint8_t>(PieceType::King);
+    const uint8_t white = static_cast<uint8_t>(Side::White);
+    const uint8_t black = static_cast<uint8_t>(Side::Black);
+
+    const Move cycle[] = {
+        Move(4, 5, king, white, Move::None, Move::None),
+        Move(60, 61, king, black, Move::None, Move::None),
+        Move(5, 4, king, white, Move::None, Move::None),
+        Move(61, 60, king, black, Move::None, Move::None),
+    };
+
+    for (const Move& m : cycle) {
+        p.ApplyMove(m);
+    }
+    QVERIFY(!p.IsThreefoldRepetition());
 
-    ZobristHash h = p.GetHash();
-    p.repetition_history_.AddPosition(h);
-    p.repetition_history_.AddPosition(h);
-    p.repetition_history_.AddPosition(h);
+    for (const Move& m : cycle) {
+        p.ApplyMove(m);
+    }
 
     // Threefold repetition must be detected
     QVERIFY(p.IsThreefoldRepetition());
 }
 
+void PositionTest::SearchRepetitionShouldBeDetectedViaKeyStack() {
+    // Knights shuffle g1-f3, g8-f6, f3-g1, f6-g8 using make/unmake only
+    Position p("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE,
+               true, true, true, true, 0);
+
+    const uint8_t knight = static_cast<uint8_t>(PieceType::Knight);
+    const uint8_t white  = static_cast<uint8_t>(Side::White);
+    const uint8_t black  = static_cast<uint8_t>(Side::Black);
+
+    const Move moves[] = {
+        Move(6, 21, knight, white, Move::None, Move::None),
+        Move(62, 45, knight, black, Move::None, Move::None),
+        Move(21, 6, knight, white, Move::None, Move::None),
+        Move(45, 62, knight, black, Move::None, Move::None),
+    };
+
+    Position::Undo undos[4];
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(!p.IsRepetition(i));
+        p.ApplyMove(moves[i], undos[i]);
+    }
+
+    // Back to the start position with the same side to move
+    QVERIFY(p.IsRepetition(4));
+
+    p.UndoMove(moves[3], undos[3]);
+    QVERIFY(!p.IsRepetition(3));
+}
+
+void PositionTest::SearchRepetitionShouldStopAtIrreversibleMove() {
+    // The pawn move resets the fifty-move counter, so older keys must be ignored
+    Position p("4k3/8/8/8/8/8/P7/4K3", Position::NONE, false, false, false, false, 0);
+
+    const uint8_t king  = static_cast<uint8_t>(PieceType::King);
+    const uint8_t pawn  = static_cast<uint8_t>(PieceType::Pawn);
+    const uint8_t white = static_cast<uint8_t>(Side::White);
+    const uint8_t black = static_cast<uint8_t>(Side::Black);
+
+    Position::Undo u;
+    p.ApplyMove(Move(4, 5, king, white, Move::None, Move::None), u);
+    p.ApplyMove(Move(60, 61, king, black, Move::None, Move::None), u);
+    p.ApplyMove(Move(8, 16, pawn, white, Move::None, Move::None), u);
+    p.ApplyMove(Move(61, 60, king, black, Move::None, Move::None), u);
+    p.ApplyMove(Move(5, 4, king, white, Move::None, Move::None), u);
+    p.ApplyMove(Move(60, 61, king, black, Move::None, Move::None), u);
+    QVERIFY(!p.IsRepetition(6));
+
+    p.ApplyMove(Move(4, 5, king, white, Move::None, Move::None), u);
+    p.ApplyMove(Move(61, 60, king, black, Move::None, Move::None), u);
+    p.ApplyMove(Move(5, 4, king, white, Move::None, Move::None), u);
+    QVERIFY(p.IsRepetition(9));
+}
+
+void PositionTest::SearchRepetitionBeforeRootShouldNeedTwoOccurrences() {
+    Position p("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE,
+               true, true, true, true, 0);
+
+    const uint8_t knight = static_cast<uint8_t>(PieceType::Knight);
+    const uint8_t white  = static_cast<uint8_t>(Side::White);
+    const uint8_t black  = static_cast<uint8_t>(Side::Black);
+
+    const Move shuffle[] = {
+        Move(6, 21, knight, white, Move::None, Move::None),
+        Move(62, 45, knight, black, Move::None, Move::None),
+        Move(21, 6, knight, white, Move::None, Move::None),
+        Move(45, 62, knight, black, Move::None, Move::None),
+    };
+
+    // The game played Nf3 Nf6 before the search started; the search returns to the start
+    // position, which the game has seen only once so far
+    Position::Undo u;
+    for (const Move& m : shuffle) {
+        p.ApplyMove(m, u);
+    }
+    QVERIFY(!p.IsRepetition(2));
+
+    // The same occurrence reached inside the search is a draw
+    QVERIFY(p.IsRepetition(4));
+
+    // Two occurrences before the root: the search would complete a threefold repetition
+    for (const Move& m : shuffle) {
+        p.ApplyMove(m, u);
+    }
+    QVERIFY(p.IsRepetition(2));
+}
+
+void PositionTest::UndoShouldRestoreHashWithEnPassant() {
+    // d2-d4 next to a black pawn on e4, then a reply; undo must restore both hashes exactly
+    Position p("4k3/8/8/8/2P1p3/8/3P4/4K3", Position::NONE, false, false, false, false, 0);
+    const uint64_t start = p.GetZobristKey();
+
+    Move push(11, 27, static_cast<uint8_t>(PieceType::Pawn), static_cast<uint8_t>(Side::White),
+              Move::None, Move::None, Move::Flag::PawnLongMove);
+    Position::Undo u1;
+    p.ApplyMove(push, u1);
+    const uint64_t after_push = p.GetZobristKey();
+
+    Move reply(60, 59, static_cast<uint8_t>(PieceType::King), static_cast<uint8_t>(Side::Black),
+               Move::None, Move::None, Move::Flag::Default);
+    Position::Undo u2;
+    p.ApplyMove(reply, u2);
+    p.UndoMove(reply, u2);
+    QCOMPARE(p.GetZobristKey(), after_push);
+
+    p.UndoMove(push, u1);
+    QCOMPARE(p.GetZobristKey(), start);
+}
+
 void PositionTest::HashShouldChangeOnPieceChanges() {
     // Place and remove a piece to verify hash changes and reverts
     Position p("8/8/8/8/8/8/8/8", Position::NONE, false, false, false, false, 0);
@@ -317,3 +469,28 @@ void PositionTest::MoveShouldNotChangeBoardOnInvalidMove() {
     // Board must remain unchanged
     QCOMPARE(before, after);
 }
+
+void PositionTest::KeyAfterShouldMatchApplyMoveOnPerftPositions() {
+    struct Case {
+        const char* fen;
+        uint8_t en_passant;
+        bool wl, ws, bl, bs;
+    };
+    // Perft suite positions plus an en-passant one: castling, promotions, captures of home rooks
+    const Case cases[] = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", Position::NONE, true, true, true, true},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R", Position::NONE, true, true, false, false},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8", Position::NONE, false, false, false, false},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1", Position::NONE, false, false, true, true},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", Position::NONE, true, true, true, true},
+        {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", Position::NONE, false, false, false, false},
+        {"rnbqkbnr/p1p1pppp/8/1pPp4/8/8/PP1PPPPP/RNBQKBNR", 43, true, true, true, true},
+    };
+
+    for (const Case& c : cases) {
+        Position pos(c.fen, c.en_passant, c.wl, c.ws, c.bl, c.bs, 0);
+        const uint64_t start = pos.GetZobristKey();
+        QCOMPARE(CountKeyAfterMismatches(pos, 3), uint64_t{0});
+        QCOMPARE(pos.GetZobristKey(), start);
+    }
+}
@@ -32,8 +32,13 @@ private slots:
 
     // === Repetition & Hash ===
     void ShouldDetectThreefoldRepetition();
+    void SearchRepetitionShouldBeDetectedViaKeyStack();
+    void SearchRepetitionShouldStopAtIrreversibleMove();
+    void SearchRepetitionBeforeRootShouldNeedTwoOccurrences();
+    void UndoShouldRestoreHashWithEnPassant();
     void HashShouldChangeOnPieceChanges();
     void HashShouldInvertOnEachMove();
+    void KeyAfterShouldMatchApplyMoveOnPerftPositions();
 
     // === Edge & Invalid Cases ===
     void MoveShouldNotChangeBoardOnInvalidMove();
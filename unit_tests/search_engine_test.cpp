@@ -1,10 +1,41 @@
 #include "search_engine_test.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
 #include "../ChessBot/src/engine_core/board_state/position.h"
 #include "../ChessBot/src/engine_core/move_generation/move_list.h"
 #include "../ChessBot/src/engine_core/move_generation/legal_move_gen.h"
 #include "../ChessBot/src/engine_core/ai_logic/search.h"
 
+namespace {
+    // Allocation counter for the test binary; only counts while enabled
+    std::atomic<bool> g_count_allocations{false};
+    std::atomic<int64_t> g_allocations{0};
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 namespace {
     Position Make(const char* boardFEN, bool whiteToMove) {
         return Position(boardFEN, Position::NONE, true, true, true, true, whiteToMove ? 0 : 1);
@@ -65,6 +96,18 @@ void SearchEngineTest::NodesLimit_ShouldBeRespected() {
 
     QVERIFY2(res.nodes <= lim.nodes_limit, "Search must respect nodes_limit");
     QVERIFY2(res.depth >= 1, "Even with nodes cap, depth should be at least 1");
+
+    // The iteration cut by the limit is discarded: the result is that of a full search to res.depth
+    TranspositionTable full_tt(8);
+    SearchEngine full_engine(full_tt);
+    SearchLimits full_lim;
+    full_lim.max_depth = res.depth;
+    const SearchResult full = full_engine.Search(pos, full_lim);
+
+    QCOMPARE(full.depth, res.depth);
+    QCOMPARE(full.score_cp, res.score_cp);
+    QCOMPARE(full.nodes, res.nodes);
+    QVERIFY(full.best_move.GetFrom() == res.best_move.GetFrom() && full.best_move.GetTo() == res.best_move.GetTo());
 }
 
 void SearchEngineTest::ScoreToTT_FromTT_ShouldRoundTrip() {
@@ -78,3 +121,336 @@ void SearchEngineTest::ScoreToTT_FromTT_ShouldRoundTrip() {
         QCOMPARE(unpack, v);
     }
 }
+
+void SearchEngineTest::Stats_ShouldCountFirstMoveCutoffs() {
+    Position pos = Make("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", true);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 5;
+    const SearchResult res = engine.Search(pos, lim);
+
+    QVERIFY(res.stats.beta_cutoffs > 0);
+    QVERIFY(res.stats.first_move_cutoffs > 0);
+    QVERIFY(res.stats.first_move_cutoffs <= res.stats.beta_cutoffs);
+
+    const double rate = res.stats.FirstMoveCutoffRate();
+    QVERIFY(rate > 0.0 && rate <= 1.0);
+
+    // The search's TT counts reach the table totals by the end of the search
+    const TranspositionTable::Counters tt_counts = tt.GetCounters();
+    QVERIFY(tt_counts.probes > 0 && tt_counts.hits > 0);
+    QVERIFY(tt_counts.stores > 0);
+
+    // Counters restart with every search
+    lim.max_depth = 1;
+    const SearchResult shallow = engine.Search(pos, lim);
+    QVERIFY(shallow.stats.beta_cutoffs < res.stats.beta_cutoffs);
+}
+
+void SearchEngineTest::AspirationStats_ShouldAddUpPerIteration() {
+    Position pos = Make("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", true);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 7;
+    const SearchResult res = engine.Search(pos, lim);
+
+    int64_t fail_highs = 0;
+    int64_t fail_lows = 0;
+    int64_t research_nodes = 0;
+    int64_t iteration_nodes = 0;
+    for (int depth = 1; depth <= res.depth; ++depth) {
+        const IterationStats& it = res.stats.iterations[depth];
+        QVERIFY(it.nodes > 0);
+        QVERIFY(it.research_nodes <= it.nodes);
+
+        // A re-search only happens after a failed window
+        if (it.fail_highs + it.fail_lows == 0) {
+            QCOMPARE(it.research_nodes, int64_t{0});
+        }
+
+        fail_highs += it.fail_highs;
+        fail_lows += it.fail_lows;
+        research_nodes += it.research_nodes;
+        iteration_nodes += it.nodes;
+    }
+
+    // The first iteration runs with the full window and cannot fail
+    QCOMPARE(res.stats.iterations[1].fail_highs + res.stats.iterations[1].fail_lows, 0);
+
+    QCOMPARE(res.stats.fail_highs, fail_highs);
+    QCOMPARE(res.stats.fail_lows, fail_lows);
+    QCOMPARE(res.stats.research_nodes, research_nodes);
+    QCOMPARE(iteration_nodes, res.nodes);
+
+    const double overhead = res.stats.ResearchOverhead();
+    QVERIFY(overhead >= 0.0 && overhead < 1.0);
+}
+
+void SearchEngineTest::MultiPv_ShouldReturnDistinctLinesOrderedByScore() {
+    Position pos = Make("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", true);
+
+    MoveList legal;
+    LegalMoveGen::Generate(pos, Side::White, legal);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 5;
+    lim.multi_pv = 4;
+    const SearchResult res = engine.Search(pos, lim);
+
+    QCOMPARE(res.line_count, 4);
+    QCOMPARE(res.score_cp, res.lines[0].score_cp);
+    QVERIFY(SearchEngine::SameMove(res.best_move, res.lines[0].moves[0]));
+
+    for (int i = 0; i < res.line_count; ++i) {
+        QVERIFY(res.lines[i].length >= 1);
+        QVERIFY(ContainsMove(legal, res.lines[i].moves[0]));
+
+        if (i > 0) {
+            QVERIFY(res.lines[i - 1].score_cp >= res.lines[i].score_cp);
+        }
+
+        for (int j = 0; j < i; ++j) {
+            QVERIFY2(!SearchEngine::SameMove(res.lines[i].moves[0], res.lines[j].moves[0]),
+                     "Every line must start with a different root move");
+        }
+    }
+
+    // More lines than legal moves: one line per legal move
+    Position few("1R6/8/7k/8/8/8/6PP/r6K", Position::NONE, false, false, false, false, 0);
+    lim.multi_pv = kMaxMultiPv;
+    const SearchResult forced = engine.Search(few, lim);
+    QCOMPARE(forced.line_count, 1);
+}
+
+void SearchEngineTest::RootMoves_ShouldKeepBestFirstWithNodeDistribution() {
+    Position pos = Make("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", true);
+
+    MoveList legal;
+    LegalMoveGen::Generate(pos, Side::White, legal);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 6;
+    const SearchResult res = engine.Search(pos, lim);
+
+    const std::vector<RootMove>& root_moves = engine.GetRootMoves();
+    QCOMPARE(root_moves.size(), static_cast<size_t>(legal.GetSize()));
+    QVERIFY(SearchEngine::SameMove(root_moves[0].move, res.best_move));
+    QCOMPARE(root_moves[0].score, res.score_cp);
+
+    // Every legal move once; ranks of the previous iteration form a permutation
+    int64_t root_nodes = 0;
+    std::vector<bool> rank_seen(root_moves.size(), false);
+    for (const RootMove& rm : root_moves) {
+        QVERIFY(ContainsMove(legal, rm.move));
+        QVERIFY(rm.previous_rank >= 0 && rm.previous_rank < static_cast<int>(root_moves.size()));
+        QVERIFY(!rank_seen[rm.previous_rank]);
+        rank_seen[rm.previous_rank] = true;
+        root_nodes += rm.nodes;
+    }
+
+    QVERIFY(root_nodes > 0);
+    QVERIFY(root_nodes <= res.stats.iterations[res.depth].nodes);
+
+    QVERIFY(res.best_move_node_share > 0.0 && res.best_move_node_share <= 1.0);
+    QCOMPARE(res.best_move_node_share, static_cast<double>(root_moves[0].nodes) / root_nodes);
+
+    // A soft node budget stops iterative deepening between iterations
+    lim.max_depth = 64;
+    lim.soft_nodes_limit = 5000;
+    const SearchResult soft = engine.Search(pos, lim);
+    QVERIFY(soft.depth < 64);
+
+    // ... and the last one started below the largest scaled budget (1.5x)
+    QVERIFY(soft.nodes - soft.stats.iterations[soft.depth].nodes < 5000 * 3 / 2);
+}
+
+void SearchEngineTest::TimeLimit_ShouldStopAfterFirstIteration() {
+    Position pos = Make("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", true);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 64;
+    lim.time_limit_ms = 50;
+
+    const auto start = std::chrono::steady_clock::now();
+    const SearchResult res = engine.Search(pos, lim);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    QVERIFY(res.depth >= 1 && res.depth < 64);
+    QVERIFY(res.best_move.GetFrom() != Move::None);
+    QVERIFY2(elapsed < std::chrono::seconds(5), "Search must stop soon after the time limit");
+}
+
+void SearchEngineTest::Ponder_ShouldRunUntilPonderhitOrStop() {
+    Position pos = Make("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", true);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchSignals signals;
+    engine.SetSignals(&signals);
+
+    SearchLimits lim;
+    lim.max_depth = 64;
+    lim.time_limit_ms = 50;
+    lim.ponder = true;
+
+    // The time limit does not run while pondering
+    std::atomic<bool> done{false};
+    SearchResult res{};
+    std::thread ponder([&]() {
+        res = engine.Search(pos, lim);
+        done = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const bool finished_early = done.load();
+
+    // Ponderhit: the same search continues with the clock started. The thread is joined before
+    // any check: a failing QVERIFY returns, and a joinable std::thread would terminate the run
+    signals.ponderhit = true;
+    ponder.join();
+
+    QVERIFY2(!finished_early, "Ponder search must wait for the ponderhit");
+
+    QVERIFY(res.depth >= 1 && res.depth < 64);
+    QVERIFY(res.best_move.GetFrom() != Move::None);
+
+    // A miss aborts the ponder search with the last completed iteration
+    signals.stop = false;
+    signals.ponderhit = false;
+    std::thread missed([&]() {
+        res = engine.Search(pos, lim);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    signals.stop = true;
+    missed.join();
+
+    QVERIFY(res.depth >= 1);
+    QVERIFY(res.best_move.GetFrom() != Move::None);
+}
+
+void SearchEngineTest::RootWithoutTTMove_ShouldSearchFullDepth() {
+    Position pos = Make("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1", true);
+
+    // Empty table: the root has no TT move, as after an overwrite, a resize or a loaded snapshot
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+    engine.AlphaBeta(pos, 4, -30000, 30000, 0);
+
+    // Internal iterative reduction must not shorten the root: its entry carries the full depth
+    TranspositionTable::Entry entry{};
+    QVERIFY(tt.Lookup(pos.GetZobristKey(), entry));
+    QCOMPARE(static_cast<int>(entry.depth), 4);
+}
+
+void SearchEngineTest::ExcludedMove_ShouldBeSkippedWithoutTouchingTT() {
+    // White is in check and Rb8-b1 is the only legal move
+    Position pos("1R6/8/7k/8/8/8/6PP/r6K", Position::NONE, false, false, false, false, 0);
+
+    MoveList legal;
+    LegalMoveGen::Generate(pos, Side::White, legal);
+    QCOMPARE(static_cast<int>(legal.GetSize()), 1);
+
+    TranspositionTable tt(1);
+    SearchEngine engine(tt);
+
+    // Verification search with the only move excluded: no alternative can reach the bound
+    engine.stack_[0].excluded_move = legal[0];
+    const int score = engine.AlphaBeta(pos, 2, -30000, 30000, 0);
+    engine.stack_[0].excluded_move = Move{};
+
+    QVERIFY(score <= -30000);
+
+    TranspositionTable::Entry entry{};
+    QVERIFY2(!tt.Lookup(pos.GetZobristKey(), entry), "Verification search must not store its result");
+
+    // The normal search of the same node plays the move and stores the node
+    engine.AlphaBeta(pos, 2, -30000, 30000, 0);
+    QVERIFY(tt.Lookup(pos.GetZobristKey(), entry));
+    QCOMPARE(entry.best_from, static_cast<int16_t>(legal[0].GetFrom()));
+}
+
+void SearchEngineTest::NoLegalMoves_ShouldScoreMateOrStalemateAndStoreExact() {
+    TranspositionTable tt(1);
+    SearchEngine engine(tt);
+
+    // Black is checkmated: a mate score at the node, stored as an exact entry
+    Position mated = Make("3R2k1/5ppp/8/8/8/8/5PPP/6K1", false);
+    const int mated_score = engine.AlphaBeta(mated, 2, -100, 100, 0);
+    QVERIFY(SearchEngine::IsMateScore(mated_score) && mated_score < 0);
+
+    TranspositionTable::Entry entry{};
+    QVERIFY(tt.Lookup(mated.GetZobristKey(), entry));
+    QVERIFY(entry.bound == TranspositionTable::Bound::Exact);
+    QCOMPARE(SearchEngine::ScoreFromTT(entry.score, 0), mated_score);
+
+    // Stalemate is a draw, not a loss
+    Position stalemate = Make("7k/5Q2/6K1/8/8/8/8/8", false);
+    QCOMPARE(engine.AlphaBeta(stalemate, 2, -100, 100, 0), 0);
+    QVERIFY(tt.Lookup(stalemate.GetZobristKey(), entry));
+    QVERIFY(entry.bound == TranspositionTable::Bound::Exact);
+    QCOMPARE(static_cast<int>(entry.score), 0);
+
+    // Mate in one: the mate one halfmove away beats the mated score by one and ends the iterations
+    Position pos = Make("6k1/5ppp/8/8/8/8/5PPP/3R2K1", true);
+    SearchLimits lim;
+    lim.max_depth = 6;
+    const SearchResult res = engine.Search(pos, lim);
+    QCOMPARE(res.score_cp, -mated_score - 1);
+    QCOMPARE(static_cast<int>(res.best_move.GetTo()), 59);
+    QVERIFY(res.depth < lim.max_depth);
+}
+
+void SearchEngineTest::LmrReduction_ShouldGrowWithDepthAndMoveIndex() {
+    // The first move and the shallowest depths are never reduced by the table alone
+    QCOMPARE(SearchEngine::LmrReduction(10, 1), 0);
+    QCOMPARE(SearchEngine::LmrReduction(1, 30), 0);
+
+    for (int depth = 2; depth < 40; ++depth) {
+        for (int index = 2; index < 40; ++index) {
+            QVERIFY(SearchEngine::LmrReduction(depth, index) >= SearchEngine::LmrReduction(depth - 1, index));
+            QVERIFY(SearchEngine::LmrReduction(depth, index) >= SearchEngine::LmrReduction(depth, index - 1));
+        }
+    }
+
+    QVERIFY(SearchEngine::LmrReduction(12, 20) >= 3);
+
+    // Out-of-table arguments are clamped to the last row/column
+    QCOMPARE(SearchEngine::LmrReduction(200, 200), SearchEngine::LmrReduction(63, 63));
+}
+
+void SearchEngineTest::Search_ShouldNotAllocatePerNode() {
+    Position pos = Make("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R", true);
+
+    TranspositionTable tt(8);
+    SearchEngine engine(tt);
+
+    SearchLimits lim;
+    lim.max_depth = 2;
+    engine.Search(pos, lim); // warm-up (stream buffers etc.)
+
+    lim.max_depth = 5;
+    g_allocations = 0;
+    g_count_allocations = true;
+    const SearchResult res = engine.Search(pos, lim);
+    g_count_allocations = false;
+
+    QVERIFY2(res.nodes > 1000, "Search should visit a meaningful number of nodes");
+    QCOMPARE(g_allocations.load(), int64_t{0});
+}
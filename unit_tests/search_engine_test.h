@@ -1,6 +1,8 @@
 /************
 * SearchEngine tests
-* Checks: PV legality, nodes limit adherence, TT score round-trip helper.
+* Checks: PV legality, nodes limit adherence (cut-off iteration discarded), TT score round-trip helper, LMR table shape, cutoff statistics,
+* full-depth root without a TT move, singular-extension verification (excluded move skipped, no TT store), mate/stalemate scoring of nodes without moves,
+* no heap allocations during search (counting operator new hook in this test build).
 ************/
 #pragma once
 
@@ -13,4 +15,15 @@ private slots:
     void PV_ShouldBeLegalSequence();
     void NodesLimit_ShouldBeRespected();
     void ScoreToTT_FromTT_ShouldRoundTrip();
+    void LmrReduction_ShouldGrowWithDepthAndMoveIndex();
+    void Stats_ShouldCountFirstMoveCutoffs();
+    void AspirationStats_ShouldAddUpPerIteration();
+    void MultiPv_ShouldReturnDistinctLinesOrderedByScore();
+    void RootMoves_ShouldKeepBestFirstWithNodeDistribution();
+    void TimeLimit_ShouldStopAfterFirstIteration();
+    void Ponder_ShouldRunUntilPonderhitOrStop();
+    void RootWithoutTTMove_ShouldSearchFullDepth();
+    void ExcludedMove_ShouldBeSkippedWithoutTouchingTT();
+    void NoLegalMoves_ShouldScoreMateOrStalemateAndStoreExact();
+    void Search_ShouldNotAllocatePerNode();
 };
@@ -0,0 +1,93 @@
+#include "search_history_test.h"
+
+#include <memory>
+
+#include "../ChessBot/src/engine_core/board_state/move.h"
+#include "../ChessBot/src/engine_core/board_state/pieces.h"
+#include "../ChessBot/src/engine_core/ai_logic/search_history.h"
+
+namespace {
+Move Quiet(uint8_t from, uint8_t to, PieceType type, Side side) {
+    return Move(from, to, static_cast<uint8_t>(type), static_cast<uint8_t>(side),
+                Move::None, Move::None, Move::Flag::Default);
+}
+
+Move Capture(uint8_t from, uint8_t to, PieceType type, Side side, PieceType victim) {
+    return Move(from, to, static_cast<uint8_t>(type), static_cast<uint8_t>(side),
+                static_cast<uint8_t>(victim), static_cast<uint8_t>(Pieces::Inverse(side)),
+                Move::Flag::Capture);
+}
+
+std::unique_ptr<SearchHistory> MakeHistory() {
+    auto history = std::make_unique<SearchHistory>();
+    history->Clear();
+    return history;
+}
+} // namespace
+
+void SearchHistoryTest::Butterfly_ShouldStayBoundedUnderRepeatedBonus() {
+    auto history = MakeHistory();
+    const Move m = Quiet(6, 21, PieceType::Knight, Side::White); // g1f3
+
+    for (int i = 0; i < 10000; ++i) {
+        history->UpdateButterfly(Side::White, m, SearchHistory::Bonus(20));
+    }
+
+    const int value = history->GetButterfly(Side::White, m);
+    QVERIFY(value > 0);
+    QVERIFY(value <= SearchHistory::kMaxValue);
+    QCOMPARE(history->GetButterfly(Side::Black, m), 0);
+}
+
+void SearchHistoryTest::Butterfly_MalusShouldLowerScore() {
+    auto history = MakeHistory();
+    const Move m = Quiet(12, 28, PieceType::Pawn, Side::White); // e2e4
+
+    history->UpdateButterfly(Side::White, m, SearchHistory::Bonus(6));
+    const int after_bonus = history->GetButterfly(Side::White, m);
+    history->UpdateButterfly(Side::White, m, -SearchHistory::Bonus(6));
+
+    QVERIFY(after_bonus > 0);
+    QVERIFY(history->GetButterfly(Side::White, m) < after_bonus);
+}
+
+void SearchHistoryTest::Countermove_ShouldBeKeyedByPreviousMove() {
+    auto history = MakeHistory();
+    const Move prev  = Quiet(52, 36, PieceType::Pawn, Side::Black);   // e7e5
+    const Move other = Quiet(51, 35, PieceType::Pawn, Side::Black);   // d7d5
+    const Move reply = Quiet(6, 21, PieceType::Knight, Side::White);  // g1f3
+
+    history->SetCountermove(prev, reply);
+
+    QCOMPARE(history->GetCountermove(prev), static_cast<uint16_t>(6 | (21 << 8)));
+    QCOMPARE(history->GetCountermove(other), static_cast<uint16_t>(0));
+
+    // Null move has no piece: nothing is stored or returned
+    history->SetCountermove(Move{}, reply);
+    QCOMPARE(history->GetCountermove(Move{}), static_cast<uint16_t>(0));
+}
+
+void SearchHistoryTest::Continuation_ShouldBeKeyedByPreviousMove() {
+    auto history = MakeHistory();
+    const Move prev  = Quiet(52, 36, PieceType::Pawn, Side::Black);
+    const Move other = Quiet(62, 45, PieceType::Knight, Side::Black);
+    const Move reply = Quiet(6, 21, PieceType::Knight, Side::White);
+
+    SearchHistory::UpdateContinuation(history->GetContinuation(prev), reply, SearchHistory::Bonus(8));
+
+    QVERIFY(SearchHistory::ContinuationValue(history->GetContinuation(prev), reply) > 0);
+    QCOMPARE(SearchHistory::ContinuationValue(history->GetContinuation(other), reply), 0);
+    QVERIFY(history->GetContinuation(Move{}) == nullptr);
+    QCOMPARE(SearchHistory::ContinuationValue(nullptr, reply), 0);
+}
+
+void SearchHistoryTest::CaptureHistory_ShouldDependOnVictim() {
+    auto history = MakeHistory();
+    const Move takes_pawn   = Capture(27, 36, PieceType::Knight, Side::White, PieceType::Pawn);
+    const Move takes_bishop = Capture(27, 36, PieceType::Knight, Side::White, PieceType::Bishop);
+
+    history->UpdateCapture(takes_pawn, -SearchHistory::Bonus(5));
+
+    QVERIFY(history->GetCapture(takes_pawn) < 0);
+    QCOMPARE(history->GetCapture(takes_bishop), 0);
+}
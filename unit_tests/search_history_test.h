@@ -0,0 +1,19 @@
+/************
+* SearchHistory tests
+* Checks: gravity keeps values bounded and lets a malus undo a bonus; countermove and
+* continuation tables are keyed by the previous move; capture history is keyed by victim.
+************/
+#pragma once
+
+#include <QObject>
+#include <QtTest>
+
+class SearchHistoryTest : public QObject {
+    Q_OBJECT
+private slots:
+    void Butterfly_ShouldStayBoundedUnderRepeatedBonus();
+    void Butterfly_MalusShouldLowerScore();
+    void Countermove_ShouldBeKeyedByPreviousMove();
+    void Continuation_ShouldBeKeyedByPreviousMove();
+    void CaptureHistory_ShouldDependOnVictim();
+};
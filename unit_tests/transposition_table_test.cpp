@@ -1,9 +1,26 @@
 #include "transposition_table_test.h"
 
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
 #include "../ChessBot/src/engine_core/ai_logic/transposition_table.h"
 #include "../ChessBot/src/engine_core/board_state/move.h"
 #include "../ChessBot/src/engine_core/board_state/pieces.h"
 
+static std::string SnapshotPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Overwrites bytes of a file in place
+static void PatchFile(const std::string& path, std::streamoff offset, const void* data, std::size_t size) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset);
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
 static Move MakeQuiet(uint8_t from, uint8_t to) {
     return Move(from, to, static_cast<uint8_t>(PieceType::Knight),
                 static_cast<uint8_t>(Side::White),
@@ -53,3 +70,280 @@ void TranspositionTableTest::Probe_ShouldMissOnShallowDepthOrWrongWindow() {
         QVERIFY(!hit); // window excludes upper-bound usefulness
     }
 }
+
+void TranspositionTableTest::Lookup_ShouldReturnRawEntryRegardlessOfWindow() {
+    TranspositionTable tt(4);
+
+    const uint64_t key = 0x5555666677778888ull;
+    const Move best = MakeQuiet(6, 21);
+
+    tt.Store(key, 3, 40, TranspositionTable::Bound::Lower, best);
+
+    // Probe rejects a deeper request, Lookup still exposes depth and bound
+    int out_score = 0; Move out_best;
+    QVERIFY(!tt.Probe(key, 8, -100, 100, out_score, out_best));
+
+    TranspositionTable::Entry entry{};
+    QVERIFY(tt.Lookup(key, entry));
+    QCOMPARE(static_cast<int>(entry.depth), 3);
+    QVERIFY(entry.bound == TranspositionTable::Bound::Lower);
+    QCOMPARE(static_cast<int>(entry.score), 40);
+    QCOMPARE(entry.best_from, static_cast<int16_t>(6));
+
+    QVERIFY(!tt.Lookup(key ^ 1, entry));
+}
+
+void TranspositionTableTest::SaveLoad_ShouldRoundTripEntriesAndSize() {
+    const std::string path = SnapshotPath("chessbot_tt_roundtrip.bin");
+
+    TranspositionTable saved(1);
+    const Move best = MakeQuiet(6, 21);
+    for (uint64_t i = 1; i <= 500; ++i) {
+        saved.Store(i * 0x9E3779B97F4A7C15ull, static_cast<int>(i % 20), static_cast<int>(i), TranspositionTable::Bound::Lower, best);
+    }
+    QVERIFY(saved.Save(path));
+
+    // The loaded table takes the size of the snapshot
+    TranspositionTable loaded(4);
+    QVERIFY(loaded.Load(path));
+    QCOMPARE(loaded.GetEntryCount(), saved.GetEntryCount());
+
+    for (uint64_t i = 1; i <= 500; ++i) {
+        const uint64_t key = i * 0x9E3779B97F4A7C15ull;
+        TranspositionTable::Entry expected{};
+        TranspositionTable::Entry actual{};
+        QCOMPARE(saved.Lookup(key, expected), loaded.Lookup(key, actual));
+        QCOMPARE(actual.score, expected.score);
+        QCOMPARE(actual.depth, expected.depth);
+        QCOMPARE(actual.best_from, expected.best_from);
+    }
+
+    // Stores after loading are private to the process: the file keeps its contents
+    const uint64_t key = 7 * 0x9E3779B97F4A7C15ull;
+    loaded.Store(key, 30, -77, TranspositionTable::Bound::Exact, best);
+    loaded.Clear();
+
+    TranspositionTable reloaded(1);
+    QVERIFY(reloaded.Load(path));
+    TranspositionTable::Entry entry{};
+    QVERIFY(reloaded.Lookup(key, entry));
+    QCOMPARE(entry.score, static_cast<int16_t>(7));
+
+    std::remove(path.c_str());
+}
+
+void TranspositionTableTest::Load_ShouldRejectCorruptOrIncompatibleFiles() {
+    const std::string path = SnapshotPath("chessbot_tt_reject.bin");
+
+    TranspositionTable saved(1);
+    saved.Store(0x1234ull, 5, 42, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    QVERIFY(saved.Save(path));
+
+    TranspositionTable table(2);
+    const uint64_t key = 0x5555ull;
+    table.Store(key, 3, 11, TranspositionTable::Bound::Upper, MakeQuiet(12, 28));
+
+    auto TableUnchanged = [&table, key]() {
+        TranspositionTable::Entry entry{};
+        return table.Lookup(key, entry) && entry.score == 11 && table.GetEntryCount() != 0;
+    };
+
+    QVERIFY(!table.Load(SnapshotPath("chessbot_tt_missing.bin")));
+    QVERIFY(TableUnchanged());
+
+    // Corrupted entry byte: checksum mismatch when the entries are verified
+    const std::streamoff entries = sizeof(TranspositionTable::FileHeader);
+    const char garbage = 0x5A;
+    PatchFile(path, entries + 3, &garbage, 1);
+    QVERIFY(!table.Load(path, true));
+    QVERIFY(TableUnchanged());
+
+    // Keys hashed with other Zobrist constants
+    QVERIFY(saved.Save(path));
+    const uint64_t foreign = 0xDEADBEEFull;
+    PatchFile(path, offsetof(TranspositionTable::FileHeader, zobrist_fingerprint), &foreign, sizeof(foreign));
+    QVERIFY(!table.Load(path));
+
+    // Another format version
+    QVERIFY(saved.Save(path));
+    const uint32_t version = TranspositionTable::kFileVersion + 1;
+    PatchFile(path, offsetof(TranspositionTable::FileHeader, version), &version, sizeof(version));
+    QVERIFY(!table.Load(path));
+
+    // Truncated file
+    QVERIFY(saved.Save(path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    QVERIFY(!table.Load(path));
+    QVERIFY(TableUnchanged());
+
+    // The intact snapshot still loads, verified or not
+    QVERIFY(saved.Save(path));
+    QVERIFY(table.Load(path, true));
+    QVERIFY(!TableUnchanged());
+
+    // Without verification only the header is checked, so corrupt entries go unnoticed
+    PatchFile(path, entries + 3, &garbage, 1);
+    QVERIFY(table.Load(path));
+
+    std::remove(path.c_str());
+}
+
+void TranspositionTableTest::LoadThenSave_ShouldKeepTableOnSamePath() {
+    const std::string path = SnapshotPath("chessbot_tt_same_path.bin");
+
+    TranspositionTable saved(1);
+    const Move best = MakeQuiet(6, 21);
+    for (uint64_t i = 1; i <= 500; ++i) {
+        saved.Store(i * 0x9E3779B97F4A7C15ull, 5, static_cast<int>(i), TranspositionTable::Bound::Exact, best);
+    }
+    QVERIFY(saved.Save(path));
+
+    // Persist between sessions: load, search on, save back to the file the table is mapped from
+    TranspositionTable session(1);
+    QVERIFY(session.Load(path));
+    session.Store(0xFEEDull, 9, -5, TranspositionTable::Bound::Lower, best);
+    QVERIFY(session.Save(path));
+    QCOMPARE(std::filesystem::file_size(path),
+             sizeof(TranspositionTable::FileHeader) + saved.GetEntryCount() * sizeof(TranspositionTable::Entry));
+    QVERIFY(!std::filesystem::exists(path + ".tmp"));
+
+    // Pages not touched before the save still read the old snapshot
+    TranspositionTable::Entry entry{};
+    for (uint64_t i = 1; i <= 500; ++i) {
+        const uint64_t key = i * 0x9E3779B97F4A7C15ull;
+        TranspositionTable::Entry expected{};
+        QCOMPARE(session.Lookup(key, entry), saved.Lookup(key, expected));
+        QCOMPARE(entry.score, expected.score);
+    }
+
+    // The next session sees both the old entries and the new store
+    TranspositionTable next(1);
+    QVERIFY(next.Load(path));
+    QVERIFY(next.Lookup(0xFEEDull, entry));
+    QCOMPARE(entry.score, static_cast<int16_t>(-5));
+    QVERIFY(next.Lookup(3 * 0x9E3779B97F4A7C15ull, entry));
+    QCOMPARE(entry.score, static_cast<int16_t>(3));
+
+    std::remove(path.c_str());
+}
+
+void TranspositionTableTest::Clear_ShouldResetEveryEntry() {
+    // Large enough for several clearing threads on multi-core machines
+    TranspositionTable tt(128);
+    QVERIFY(tt.GetEntryCount() >= (1ull << 22));
+
+    const uint64_t count = tt.GetEntryCount();
+    const uint64_t stride = count / 1024 + 1;
+    for (uint64_t i = 0; i < count; i += stride) {
+        tt.Store(i | 0xABC0000000000000ull, 4, 9, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    }
+
+    // The last entry belongs to the last thread's range
+    tt.Store((count - 1) | 0xABC0000000000000ull, 4, 9, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+
+    tt.Clear();
+
+    TranspositionTable::Entry entry{};
+    for (uint64_t i = 0; i < count; i += stride) {
+        QVERIFY(!tt.Lookup(i | 0xABC0000000000000ull, entry));
+    }
+    QVERIFY(!tt.Lookup((count - 1) | 0xABC0000000000000ull, entry));
+
+    // Cleared entries carry the default (empty) values
+    QVERIFY(tt.Lookup(0, entry));
+    QCOMPARE(entry.depth, static_cast<int8_t>(-1));
+    QCOMPARE(entry.best_from, static_cast<int16_t>(-1));
+}
+
+void TranspositionTableTest::Resize_ShouldReplaceTableAndResetStatistics() {
+    TranspositionTable tt(1);
+    const uint64_t small = tt.GetEntryCount();
+    QCOMPARE(tt.HashfullPermille(), 0);
+
+    // Fill every sampled slot: the first 1000 indices
+    for (uint64_t i = 0; i < 1000; ++i) {
+        tt.Store(i | (1ull << 40), 3, 0, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    }
+    QCOMPARE(tt.HashfullPermille(), 1000);
+
+    // Half of them
+    QVERIFY(tt.Resize(1) == TranspositionTable::ResizeResult::Resized);
+    for (uint64_t i = 0; i < 1000; i += 2) {
+        tt.Store(i | (1ull << 40), 3, 0, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    }
+    QCOMPARE(tt.HashfullPermille(), 500);
+
+    QVERIFY(tt.Resize(4) == TranspositionTable::ResizeResult::Resized);
+    QCOMPARE(tt.GetEntryCount(), small * 4);
+    QCOMPARE(tt.HashfullPermille(), 0);
+    QCOMPARE(tt.GetCounters().stores, uint64_t{0});
+
+    TranspositionTable::Entry entry{};
+    QVERIFY(!tt.Lookup(2 | (1ull << 40), entry));
+
+    // A size no address space can hold: the 1 MB fallback is reported and usable
+    QVERIFY(tt.Resize(std::size_t{1} << 40) == TranspositionTable::ResizeResult::Fallback);
+    QCOMPARE(tt.GetEntryCount(), small);
+    tt.Store(0x77ull, 2, 5, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    QVERIFY(tt.Lookup(0x77ull, entry));
+
+    // The constructor takes the fallback too instead of throwing
+    TranspositionTable huge(std::size_t{1} << 40);
+    QCOMPARE(huge.GetEntryCount(), small);
+}
+
+void TranspositionTableTest::HashfullPermille_ShouldCountCurrentSearchOnly() {
+    TranspositionTable tt(1);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        tt.Store(i | (1ull << 40), 3, 0, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    }
+    QCOMPARE(tt.HashfullPermille(), 1000);
+
+    // The next search starts with the old entries still probeable but not counted
+    tt.NewSearch();
+    QCOMPARE(tt.HashfullPermille(), 0);
+
+    TranspositionTable::Entry entry{};
+    QVERIFY(tt.Lookup(4 | (1ull << 40), entry));
+
+    // Entries rewritten by the new search count again
+    for (uint64_t i = 0; i < 1000; i += 4) {
+        tt.Store(i | (1ull << 40), 4, 0, TranspositionTable::Bound::Exact, MakeQuiet(1, 18));
+    }
+    QCOMPARE(tt.HashfullPermille(), 250);
+}
+
+void TranspositionTableTest::Counters_ShouldClassifyProbesAndStores() {
+    TranspositionTable tt(1);
+    const uint64_t count = tt.GetEntryCount();
+
+    const uint64_t a = 5;
+    const uint64_t b = 5 + count; // same slot as a
+
+    TranspositionTable::Counters local{};
+    int score = 0;
+    Move move;
+    tt.Probe(a, 1, -10, 10, score, move, &local); // miss on an empty slot
+    tt.Store(a, 4, 1, TranspositionTable::Bound::Exact, MakeQuiet(1, 18), &local);
+    tt.Probe(a, 1, -10, 10, score, move, &local); // hit
+    tt.Probe(a, 9, -10, 10, score, move, &local); // hit, even if too shallow for a cutoff
+    tt.Probe(b, 1, -10, 10, score, move, &local); // miss on a slot used by a: collision
+    tt.Store(a, 6, 2, TranspositionTable::Bound::Exact, MakeQuiet(1, 18), &local); // same key: no overwrite
+    tt.Store(b, 4, 3, TranspositionTable::Bound::Exact, MakeQuiet(1, 18), &local); // overwrite
+    tt.Probe(b, 1, -10, 10, score, move);          // uncounted
+
+    // Nothing reaches the shared totals until the caller adds its counts
+    QCOMPARE(tt.GetCounters().probes, uint64_t{0});
+    tt.AddCounters(local);
+
+    const TranspositionTable::Counters c = tt.GetCounters();
+    QCOMPARE(c.probes, uint64_t{4});
+    QCOMPARE(c.hits, uint64_t{2});
+    QCOMPARE(c.misses, uint64_t{2});
+    QCOMPARE(c.collisions, uint64_t{1});
+    QCOMPARE(c.stores, uint64_t{3});
+    QCOMPARE(c.overwrites, uint64_t{1});
+
+    tt.ResetCounters();
+    QCOMPARE(tt.GetCounters().probes, uint64_t{0});
+}
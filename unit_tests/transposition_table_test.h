@@ -1,6 +1,7 @@
 /************
 * TranspositionTable tests
-* Checks: store-probe behavior for bounds and depth.
+* Checks: store-probe behavior for bounds and depth; raw entry lookup; snapshot save/load;
+* clearing of a table split across threads; runtime resize, hashfull and probe/store counters.
 ************/
 #pragma once
 
@@ -12,4 +13,12 @@ class TranspositionTableTest : public QObject {
 private slots:
     void Probe_ShouldHitWithEnoughDepthAndWindow();
     void Probe_ShouldMissOnShallowDepthOrWrongWindow();
+    void Lookup_ShouldReturnRawEntryRegardlessOfWindow();
+    void SaveLoad_ShouldRoundTripEntriesAndSize();
+    void Load_ShouldRejectCorruptOrIncompatibleFiles();
+    void LoadThenSave_ShouldKeepTableOnSamePath();
+    void Clear_ShouldResetEveryEntry();
+    void Resize_ShouldReplaceTableAndResetStatistics();
+    void HashfullPermille_ShouldCountCurrentSearchOnly();
+    void Counters_ShouldClassifyProbesAndStores();
 };
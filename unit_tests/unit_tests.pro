@@ -7,11 +7,15 @@ CONFIG += c++20
 
 TEMPLATE = app
 
+# game_controller includes its engine headers relative to an engine_core subdirectory
+INCLUDEPATH += ../ChessBot/src/engine_core/ai_logic
+
 SOURCES +=  \
     ../ChessBot/src/engine_core/board_state/pieces.cpp \
     ../ChessBot/src/engine_core/board_state/bitboard.cpp \
     ../ChessBot/src/engine_core/board_state/move.cpp \
     ../ChessBot/src/engine_core/board_state/zobrist_hash.cpp \
+    ../ChessBot/src/engine_core/board_state/cuckoo_table.cpp \
     ../ChessBot/src/engine_core/board_state/position.cpp \
     ../ChessBot/src/engine_core/board_state/repetition_history.cpp\
     ../ChessBot/src/engine_core/move_generation/ps_legal_move_mask_gen.cpp \
@@ -21,34 +25,44 @@ SOURCES +=  \
     ../ChessBot/src/engine_core/ai_logic/move_ordering.cpp \
     ../ChessBot/src/engine_core/ai_logic/static_exchange_evaluation.cpp \
     ../ChessBot/src/engine_core/ai_logic/search.cpp \
+    ../ChessBot/src/engine_core/ai_logic/search_history.cpp \
     ../ChessBot/src/engine_core/ai_logic/transposition_table.cpp \
+    ../ChessBot/src/game_controller/game_controller.cpp \
     \
     bitboard_test.cpp \
+    cuckoo_table_test.cpp \
     evaluation_test.cpp \
+    game_controller_test.cpp \
     legal_move_gen_test.cpp \
     legal_move_gen_tester.cpp \
     main_test.cpp \
     mask_gen_test.cpp \
+    micro_benchmarks.cpp \
     move_ordering_test.cpp \
     move_test.cpp \
     pieces_test.cpp \
     position_test.cpp \
     search_engine_test.cpp \
+    search_history_test.cpp \
     see_test.cpp \
     transposition_table_test.cpp \
     zobrist_hash_test.cpp
 
 HEADERS += \
     bitboard_test.h \
+    cuckoo_table_test.h \
     evaluation_test.h \
+    game_controller_test.h \
     legal_move_gen_test.h \
     legal_move_gen_tester.h \
     mask_gen_test.h \
+    micro_benchmarks.h \
     move_ordering_test.h \
     move_test.h \
     pieces_test.h \
     position_test.h \
     search_engine_test.h \
+    search_history_test.h \
     see_test.h \
     transposition_table_test.h \
     zobrist_hash_test.h
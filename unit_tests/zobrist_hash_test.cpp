@@ -3,9 +3,9 @@
 #include "../ChessBot/src/engine_core/board_state/zobrist_hash.h"
 #include "../ChessBot/src/engine_core/board_state/pieces.h"
 
-void ZobristHashTest::IdenticalPositionsShouldHaveSameHash() {
-    ZobristHash::InitConstants();
+#include <set>
 
+void ZobristHashTest::IdenticalPositionsShouldHaveSameHash() {
     Pieces p1("8/8/8/8/8/8/pppppppp/PPPPPPPP");
     Pieces p2("8/8/8/8/8/8/pppppppp/PPPPPPPP");
 
@@ -16,8 +16,6 @@ void ZobristHashTest::IdenticalPositionsShouldHaveSameHash() {
 }
 
 void ZobristHashTest::DifferentPositionsShouldHaveDifferentHash() {
-    ZobristHash::InitConstants();
-
     Pieces p1("8/8/8/8/8/8/pppppppp/PPPPPPPP");
     Pieces p2("8/8/8/8/8/8/pppppppp/PPP1PPPP");  // убрали одну пешку
 
@@ -28,8 +26,6 @@ void ZobristHashTest::DifferentPositionsShouldHaveDifferentHash() {
 }
 
 void ZobristHashTest::InvertPieceShouldBeReversible() {
-    ZobristHash::InitConstants();
-
     Pieces p("8/8/8/8/8/8/pppppppp/PPPPPPPP");
     ZobristHash h(p, true, false, false, false, false);
 
@@ -43,8 +39,6 @@ void ZobristHashTest::InvertPieceShouldBeReversible() {
 }
 
 void ZobristHashTest::InvertMoveShouldFlipHash() {
-    ZobristHash::InitConstants();
-
     Pieces p("8/8/8/8/8/8/pppppppp/PPPPPPPP");
     ZobristHash h(p, false, false, false, false, false);
 
@@ -57,8 +51,6 @@ void ZobristHashTest::InvertMoveShouldFlipHash() {
 }
 
 void ZobristHashTest::CastlingFlagsShouldAffectHash() {
-    ZobristHash::InitConstants();
-
     Pieces p("8/8/8/8/8/8/pppppppp/PPPPPPPP");
 
     ZobristHash h1(p, false, false, false, false, false);
@@ -68,3 +60,39 @@ void ZobristHashTest::CastlingFlagsShouldAffectHash() {
     QVERIFY(h1.GetValue() != h2.GetValue());
     QVERIFY(h2.GetValue() != h3.GetValue());
 }
+
+void ZobristHashTest::KeysShouldBeReproducibleFromSeed() {
+    // The tables are built by the compiler
+    static_assert(ZobristHash::PieceKey(0, 0, 0) == ZobristKeys::kKeys.pieces[0][0][0]);
+    static_assert(ZobristHash::Fingerprint() != 0);
+
+    // Pinned values: a change here invalidates every stored key (TT snapshots)
+    QCOMPARE(ZobristHash::PieceKey(0, 0, 0), 0x3af61262890f3c7bull);
+    QCOMPARE(ZobristHash::BlackToMoveKey(), 0x550fb9f198e2a7c9ull);
+    QCOMPARE(ZobristKeys::kKeys.en_passant_files[7], 0x3690b397e55b41acull);
+    QCOMPARE(ZobristHash::Fingerprint(), 0x2997ceb8e5486691ull);
+
+    // Generating at runtime from the same seed gives the same key set
+    const ZobristKeys::KeySet runtime = ZobristKeys::Generate(ZobristHash::kSeed);
+    QVERIFY(runtime.pieces == ZobristKeys::kKeys.pieces);
+    QVERIFY(runtime.en_passant_files == ZobristKeys::kKeys.en_passant_files);
+    QCOMPARE(ZobristKeys::Fingerprint(runtime, ZobristHash::kSeed), ZobristHash::Fingerprint());
+    QVERIFY(ZobristKeys::Fingerprint(ZobristKeys::Generate(ZobristHash::kSeed + 1), ZobristHash::kSeed + 1) !=
+            ZobristHash::Fingerprint());
+
+    // All 781 keys are distinct and non-zero
+    std::set<uint64_t> keys;
+    for (const auto& by_side : ZobristKeys::kKeys.pieces) {
+        for (const auto& by_type : by_side) {
+            keys.insert(by_type.begin(), by_type.end());
+        }
+    }
+    keys.insert(ZobristKeys::kKeys.en_passant_files.begin(), ZobristKeys::kKeys.en_passant_files.end());
+    keys.insert(ZobristKeys::kKeys.black_to_move);
+    keys.insert(ZobristKeys::kKeys.white_long_castling);
+    keys.insert(ZobristKeys::kKeys.white_short_castling);
+    keys.insert(ZobristKeys::kKeys.black_long_castling);
+    keys.insert(ZobristKeys::kKeys.black_short_castling);
+    QCOMPARE(keys.size(), std::size_t{64 * 2 * 6 + 8 + 5});
+    QVERIFY(keys.count(0) == 0);
+}
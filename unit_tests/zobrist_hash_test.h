@@ -12,4 +12,5 @@ private slots:
     void InvertPieceShouldBeReversible();
     void InvertMoveShouldFlipHash();
     void CastlingFlagsShouldAffectHash();
+    void KeysShouldBeReproducibleFromSeed();
 };